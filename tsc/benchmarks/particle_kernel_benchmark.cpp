@@ -0,0 +1,220 @@
+/***************************************************************************
+ * particle_kernel_benchmark.cpp - Compares the particle kernel with the plain loops
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* Built with -DENABLE_BENCHMARKS=ON as particle_kernel_benchmark
+ * Updates 1k, 10k and 100k particles with the selected kernel and with the
+ * plain loops cParticle_Emitter::Update_Particles used before, prints the
+ * times and fails if the results are not bit-identical.
+*/
+
+#include "../src/video/particle_kernel.hpp"
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+using namespace TSC;
+
+// The arrays of Benchmark_Particles used by the kernel
+struct Benchmark_Particles {
+    inline unsigned int Size(void) const
+    {
+        return m_fade_pos.size();
+    };
+
+    Particle_Kernel_Arrays Get_Kernel_Arrays(void)
+    {
+        Particle_Kernel_Arrays arrays;
+        arrays.m_pos_x = m_pos_x.data();
+        arrays.m_pos_y = m_pos_y.data();
+        arrays.m_vel_x = m_vel_x.data();
+        arrays.m_vel_y = m_vel_y.data();
+        arrays.m_gravity_x = m_gravity_x.data();
+        arrays.m_gravity_y = m_gravity_y.data();
+        arrays.m_scale = m_scale.data();
+        arrays.m_start_scale = m_start_scale.data();
+        arrays.m_fade_pos = m_fade_pos.data();
+        arrays.m_time_to_live = m_time_to_live.data();
+        arrays.m_count = Size();
+
+        return arrays;
+    };
+
+    vector<float> m_pos_x;
+    vector<float> m_pos_y;
+    vector<float> m_vel_x;
+    vector<float> m_vel_y;
+    vector<float> m_gravity_x;
+    vector<float> m_gravity_y;
+    vector<float> m_rot_z;
+    vector<float> m_const_rot_z;
+    vector<float> m_scale;
+    vector<float> m_start_scale;
+    vector<float> m_fade_pos;
+    vector<float> m_time_to_live;
+};
+
+/* *** *** *** *** *** *** *** Plain loops *** *** *** *** *** *** *** *** *** *** */
+
+static void Plain_Integrate(Benchmark_Particles& particles, float fade_speed, float speed_factor)
+{
+    for (unsigned int i = 0; i < particles.Size(); i++) {
+        particles.m_fade_pos[i] -= fade_speed / particles.m_time_to_live[i];
+
+        particles.m_pos_x[i] += particles.m_vel_x[i] * speed_factor;
+        particles.m_pos_y[i] += particles.m_vel_y[i] * speed_factor;
+        particles.m_vel_x[i] += particles.m_gravity_x[i] * speed_factor;
+        particles.m_vel_y[i] += particles.m_gravity_y[i] * speed_factor;
+    }
+}
+
+static void Plain_Fade_Size(Benchmark_Particles& particles)
+{
+    for (unsigned int i = 0; i < particles.Size(); i++) {
+        if (particles.m_fade_pos[i] > 0.0f) {
+            particles.m_scale[i] = particles.m_start_scale[i] * particles.m_fade_pos[i];
+        }
+    }
+}
+
+static void Plain_Rotate(vector<float>& rot, const vector<float>& const_rot, float speed_factor)
+{
+    for (unsigned int i = 0; i < rot.size(); i++) {
+        // not 0 with the tolerance of Is_Float_Equal()
+        if (!(fabs(const_rot[i]) <= 0.0001f)) {
+            rot[i] = fmod(rot[i] + (const_rot[i] * speed_factor), 360.0f);
+        }
+    }
+}
+
+/* *** *** *** *** *** *** *** Benchmark *** *** *** *** *** *** *** *** *** *** */
+
+// deterministic values from min to max
+static float Next_Value(uint32_t& state, float min, float max)
+{
+    state = state * 1664525u + 1013904223u;
+    return min + ((max - min) * static_cast<float>(state >> 8) * (1.0f / 16777216.0f));
+}
+
+static void Fill_Particles(Benchmark_Particles& particles, unsigned int count)
+{
+    uint32_t state = count;
+    vector<float>* const arrays[] = {&particles.m_pos_x, &particles.m_pos_y, &particles.m_vel_x, &particles.m_vel_y,
+                                     &particles.m_gravity_x, &particles.m_gravity_y, &particles.m_rot_z, &particles.m_const_rot_z,
+                                     &particles.m_scale, &particles.m_start_scale, &particles.m_fade_pos, &particles.m_time_to_live
+                                    };
+
+    for (unsigned int i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++) {
+        arrays[i]->resize(count);
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        particles.m_pos_x[i] = Next_Value(state, -5000.0f, 5000.0f);
+        particles.m_pos_y[i] = Next_Value(state, -5000.0f, 5000.0f);
+        particles.m_vel_x[i] = Next_Value(state, -10.0f, 10.0f);
+        particles.m_vel_y[i] = Next_Value(state, -10.0f, 10.0f);
+        particles.m_gravity_x[i] = Next_Value(state, -0.5f, 0.5f);
+        particles.m_gravity_y[i] = Next_Value(state, -0.5f, 0.5f);
+        particles.m_rot_z[i] = Next_Value(state, -360.0f, 360.0f);
+        // some do not rotate and some wrap each update
+        particles.m_const_rot_z[i] = (i % 5 == 0) ? 0.0f : Next_Value(state, -400.0f, 400.0f);
+        // fmod gives -0 for -360
+        if (i % 7 == 0) {
+            particles.m_rot_z[i] = -300.0f;
+            particles.m_const_rot_z[i] = -60.0f;
+        }
+        particles.m_start_scale[i] = Next_Value(state, 0.1f, 2.0f);
+        particles.m_scale[i] = particles.m_start_scale[i];
+        particles.m_fade_pos[i] = Next_Value(state, -0.1f, 1.0f);
+        particles.m_time_to_live[i] = Next_Value(state, 0.5f, 5.0f);
+    }
+}
+
+static bool Is_Identical(const vector<float>& a, const vector<float>& b)
+{
+    return a.size() == b.size() && (a.empty() || memcmp(&a[0], &b[0], a.size() * sizeof(float)) == 0);
+}
+
+static bool Is_Identical(const Benchmark_Particles& a, const Benchmark_Particles& b)
+{
+    return Is_Identical(a.m_pos_x, b.m_pos_x) && Is_Identical(a.m_pos_y, b.m_pos_y) &&
+           Is_Identical(a.m_vel_x, b.m_vel_x) && Is_Identical(a.m_vel_y, b.m_vel_y) &&
+           Is_Identical(a.m_fade_pos, b.m_fade_pos) && Is_Identical(a.m_scale, b.m_scale) &&
+           Is_Identical(a.m_rot_z, b.m_rot_z);
+}
+
+// Return the milliseconds for the given updates
+static double Run_Updates(Benchmark_Particles& particles, unsigned int updates, bool kernel)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < updates; i++) {
+        if (kernel) {
+            const Particle_Kernel_Arrays arrays = particles.Get_Kernel_Arrays();
+            Particle_Kernel_Integrate(arrays, 0.01f, 1.0f);
+            Particle_Kernel_Fade_Size(arrays);
+            Particle_Kernel_Rotate(&particles.m_rot_z[0], &particles.m_const_rot_z[0], particles.Size(), 1.0f);
+        }
+        else {
+            Plain_Integrate(particles, 0.01f, 1.0f);
+            Plain_Fade_Size(particles);
+            Plain_Rotate(particles.m_rot_z, particles.m_const_rot_z, 1.0f);
+        }
+    }
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(void)
+{
+    const unsigned int counts[] = {1000, 10000, 100000};
+    bool identical = 1;
+
+    cout << "Particle kernel : " << Particle_Kernel_Name() << endl;
+
+    for (unsigned int i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        const unsigned int count = counts[i];
+        // about 10 million particle updates for each count
+        const unsigned int updates = 10000000 / count;
+
+        Benchmark_Particles plain;
+        Benchmark_Particles vectorized;
+        Fill_Particles(plain, count);
+        Fill_Particles(vectorized, count);
+
+        // compared after the first update and after all of them
+        Run_Updates(plain, 1, 0);
+        Run_Updates(vectorized, 1, 1);
+        bool same = Is_Identical(plain, vectorized);
+
+        const double plain_time = Run_Updates(plain, updates, 0);
+        const double kernel_time = Run_Updates(vectorized, updates, 1);
+        same = same && Is_Identical(plain, vectorized);
+
+        if (!same) {
+            identical = 0;
+        }
+
+        cout << setw(6) << count << " particles x " << setw(5) << updates << " updates : plain " << fixed << setprecision(2) << plain_time
+             << " ms, kernel " << kernel_time << " ms, " << (plain_time / kernel_time) << "x, " << (same ? "identical" : "DIFFERENT") << endl;
+    }
+
+    return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -79,6 +79,8 @@ void cRandom_Sound::Init(void)
     m_massive_type = MASS_PASSIVE;
     m_editor_pos_z = 0.111f;
     m_camera_range = 0;
+    // the sound distance is checked by itself
+    m_always_active = 1;
     m_name = "Sound";
 
     m_rect.m_w = 10.0f;
@@ -0,0 +1,300 @@
+/***************************************************************************
+ * col_rect_cache.cpp - Packed collision rects for batch intersection tests
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/col_rect_cache.hpp"
+#include "../core/math/rect.hpp"
+#include "../objects/sprite.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TSC_COL_RECT_X86 1
+#include <immintrin.h>
+#endif
+
+namespace TSC {
+
+/* *** *** *** *** *** *** Batch kernel *** *** *** *** *** *** *** *** *** *** *** */
+
+/* The kernels test all slots in batches of 8 against the query bounds
+ * with the same comparisons as GL_rect::Intersects() so that the results
+ * are identical, also for NaN. They use AVX or SSE2 on x86 if the CPU
+ * supports it, selected on the first query.
+*/
+
+typedef void (*Intersect_Kernel)(vector<unsigned int>& result, const float* x, const float* y, const float* w, const float* h, const unsigned char* usable,
+                                 unsigned int count, float left, float top, float right, float bottom);
+
+// Add the usable slots of the batch mask to the result
+static inline void Add_Batch_Slots(vector<unsigned int>& result, const unsigned char* usable, unsigned int first, unsigned int mask)
+{
+    for (unsigned int slot = first; mask; slot++, mask >>= 1) {
+        if ((mask & 1) && usable[slot]) {
+            result.push_back(slot);
+        }
+    }
+}
+
+static void Intersect_Scalar(vector<unsigned int>& result, const float* x, const float* y, const float* w, const float* h, const unsigned char* usable,
+                             unsigned int count, float left, float top, float right, float bottom)
+{
+    for (unsigned int first = 0; first < count; first += 8) {
+        unsigned int mask = 0;
+
+        for (unsigned int i = 0; i < 8; i++) {
+            const unsigned int slot = first + i;
+
+            if (x[slot] + w[slot] < left || x[slot] > right || y[slot] + h[slot] < top || y[slot] > bottom) {
+                continue;
+            }
+
+            mask |= 1 << i;
+        }
+
+        Add_Batch_Slots(result, usable, first, mask);
+    }
+}
+
+#ifdef TSC_COL_RECT_X86
+
+__attribute__((target("sse2")))
+static inline unsigned int Intersect_Half_SSE2(const float* x, const float* y, const float* w, const float* h, const __m128& left, const __m128& top, const __m128& right, const __m128& bottom)
+{
+    const __m128 rect_x = _mm_loadu_ps(x);
+    const __m128 rect_y = _mm_loadu_ps(y);
+    const __m128 rect_right = _mm_add_ps(rect_x, _mm_loadu_ps(w));
+    const __m128 rect_bottom = _mm_add_ps(rect_y, _mm_loadu_ps(h));
+
+    __m128 outside = _mm_cmplt_ps(rect_right, left);
+    outside = _mm_or_ps(outside, _mm_cmpgt_ps(rect_x, right));
+    outside = _mm_or_ps(outside, _mm_cmplt_ps(rect_bottom, top));
+    outside = _mm_or_ps(outside, _mm_cmpgt_ps(rect_y, bottom));
+
+    return ~static_cast<unsigned int>(_mm_movemask_ps(outside)) & 0xF;
+}
+
+__attribute__((target("sse2")))
+static void Intersect_SSE2(vector<unsigned int>& result, const float* x, const float* y, const float* w, const float* h, const unsigned char* usable,
+                           unsigned int count, float left, float top, float right, float bottom)
+{
+    const __m128 query_left = _mm_set1_ps(left);
+    const __m128 query_top = _mm_set1_ps(top);
+    const __m128 query_right = _mm_set1_ps(right);
+    const __m128 query_bottom = _mm_set1_ps(bottom);
+
+    for (unsigned int first = 0; first < count; first += 8) {
+        const unsigned int mask = Intersect_Half_SSE2(x + first, y + first, w + first, h + first, query_left, query_top, query_right, query_bottom) |
+                                  (Intersect_Half_SSE2(x + first + 4, y + first + 4, w + first + 4, h + first + 4, query_left, query_top, query_right, query_bottom) << 4);
+
+        Add_Batch_Slots(result, usable, first, mask);
+    }
+}
+
+__attribute__((target("avx")))
+static void Intersect_AVX(vector<unsigned int>& result, const float* x, const float* y, const float* w, const float* h, const unsigned char* usable,
+                          unsigned int count, float left, float top, float right, float bottom)
+{
+    const __m256 query_left = _mm256_set1_ps(left);
+    const __m256 query_top = _mm256_set1_ps(top);
+    const __m256 query_right = _mm256_set1_ps(right);
+    const __m256 query_bottom = _mm256_set1_ps(bottom);
+
+    for (unsigned int first = 0; first < count; first += 8) {
+        const __m256 rect_x = _mm256_loadu_ps(x + first);
+        const __m256 rect_y = _mm256_loadu_ps(y + first);
+        const __m256 rect_right = _mm256_add_ps(rect_x, _mm256_loadu_ps(w + first));
+        const __m256 rect_bottom = _mm256_add_ps(rect_y, _mm256_loadu_ps(h + first));
+
+        __m256 outside = _mm256_cmp_ps(rect_right, query_left, _CMP_LT_OQ);
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(rect_x, query_right, _CMP_GT_OQ));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(rect_bottom, query_top, _CMP_LT_OQ));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(rect_y, query_bottom, _CMP_GT_OQ));
+
+        Add_Batch_Slots(result, usable, first, ~static_cast<unsigned int>(_mm256_movemask_ps(outside)) & 0xFF);
+    }
+}
+
+#endif
+
+static Intersect_Kernel Select_Intersect_Kernel(void)
+{
+#ifdef TSC_COL_RECT_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx")) {
+        return Intersect_AVX;
+    }
+    else if (__builtin_cpu_supports("sse2")) {
+        return Intersect_SSE2;
+    }
+#endif
+
+    return Intersect_Scalar;
+}
+
+// selected once on the first use
+static Intersect_Kernel Get_Intersect_Kernel(void)
+{
+    static const Intersect_Kernel kernel = Select_Intersect_Kernel();
+    return kernel;
+}
+
+/* *** *** *** *** *** *** cCol_Rect_Cache *** *** *** *** *** *** *** *** *** *** *** */
+
+const unsigned int cCol_Rect_Cache::m_batch_size = 8;
+const unsigned int cCol_Rect_Cache::m_cell_lookup_cost = 16;
+
+cCol_Rect_Cache::cCol_Rect_Cache(void)
+{
+    m_used_size = 0;
+    m_count = 0;
+}
+
+cCol_Rect_Cache::~cCol_Rect_Cache(void)
+{
+    Clear();
+}
+
+void cCol_Rect_Cache::Insert(cSprite* sprite)
+{
+    if (!sprite) {
+        return;
+    }
+
+    cCol_Rect_Cache_Entry& entry = sprite->m_col_rect_cache_entry;
+
+    // already stored
+    if (entry.m_cache == this) {
+        Update(sprite);
+        return;
+    }
+    // stored in another cache
+    else if (entry.m_cache) {
+        entry.m_cache->Remove(sprite);
+    }
+
+    unsigned int slot;
+
+    if (!m_free_slots.empty()) {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+    else {
+        slot = m_used_size;
+        m_used_size++;
+
+        // add a new padded batch
+        if (slot >= m_sprites.size()) {
+            const size_t new_size = m_sprites.size() + m_batch_size;
+
+            m_x.resize(new_size);
+            m_y.resize(new_size);
+            m_w.resize(new_size);
+            m_h.resize(new_size);
+            m_usable.resize(new_size);
+            m_sprites.resize(new_size, NULL);
+
+            for (size_t i = slot; i < new_size; i++) {
+                Clear_Slot(static_cast<unsigned int>(i));
+            }
+        }
+    }
+
+    entry.m_cache = this;
+    entry.m_slot = slot;
+    m_sprites[slot] = sprite;
+    m_count++;
+
+    Update(sprite);
+}
+
+void cCol_Rect_Cache::Remove(cSprite* sprite)
+{
+    if (!sprite) {
+        return;
+    }
+
+    cCol_Rect_Cache_Entry& entry = sprite->m_col_rect_cache_entry;
+
+    // not stored here
+    if (entry.m_cache != this) {
+        return;
+    }
+
+    Clear_Slot(entry.m_slot);
+    m_free_slots.push_back(entry.m_slot);
+
+    entry.m_cache = NULL;
+    m_count--;
+}
+
+void cCol_Rect_Cache::Update(const cSprite* sprite)
+{
+    const cCol_Rect_Cache_Entry& entry = sprite->m_col_rect_cache_entry;
+
+    // not stored here
+    if (entry.m_cache != this) {
+        return;
+    }
+
+    const unsigned int slot = entry.m_slot;
+
+    m_x[slot] = sprite->m_col_rect.m_x;
+    m_y[slot] = sprite->m_col_rect.m_y;
+    m_w[slot] = sprite->m_col_rect.m_w;
+    m_h[slot] = sprite->m_col_rect.m_h;
+    m_usable[slot] = !sprite->m_auto_destroy;
+}
+
+void cCol_Rect_Cache::Clear(void)
+{
+    for (vector<cSprite*>::iterator itr = m_sprites.begin(); itr != m_sprites.end(); ++itr) {
+        if (*itr) {
+            (*itr)->m_col_rect_cache_entry.m_cache = NULL;
+        }
+    }
+
+    m_x.clear();
+    m_y.clear();
+    m_w.clear();
+    m_h.clear();
+    m_usable.clear();
+    m_sprites.clear();
+    m_free_slots.clear();
+    m_used_size = 0;
+    m_count = 0;
+}
+
+void cCol_Rect_Cache::Query(vector<unsigned int>& result, const GL_rect& rect) const
+{
+    if (!m_used_size) {
+        return;
+    }
+
+    Get_Intersect_Kernel()(result, &m_x[0], &m_y[0], &m_w[0], &m_h[0], &m_usable[0], m_used_size,
+                           rect.m_x, rect.m_y, rect.m_x + rect.m_w, rect.m_y + rect.m_h);
+}
+
+void cCol_Rect_Cache::Clear_Slot(unsigned int slot)
+{
+    m_x[slot] = -FLT_MAX;
+    m_y[slot] = -FLT_MAX;
+    m_w[slot] = 0.0f;
+    m_h[slot] = 0.0f;
+    m_usable[slot] = 0;
+    m_sprites[slot] = NULL;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
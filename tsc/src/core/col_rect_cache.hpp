@@ -0,0 +1,118 @@
+/***************************************************************************
+ * col_rect_cache.hpp - Packed collision rects for batch intersection tests
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_COL_RECT_CACHE_HPP
+#define TSC_COL_RECT_CACHE_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
+
+namespace TSC {
+
+    class cCol_Rect_Cache;
+
+    /* *** *** *** *** *** *** *** cCol_Rect_Cache_Entry *** *** *** *** *** *** *** *** *** *** */
+
+    /* The cache slot a sprite collision rect is mirrored in.
+     * Copying a sprite never copies the registration.
+     */
+    class cCol_Rect_Cache_Entry {
+    public:
+        cCol_Rect_Cache_Entry(void)
+            : m_cache(NULL), m_slot(0) {}
+        cCol_Rect_Cache_Entry(const cCol_Rect_Cache_Entry&)
+            : m_cache(NULL), m_slot(0) {}
+
+        inline cCol_Rect_Cache_Entry& operator = (const cCol_Rect_Cache_Entry&)
+        {
+            return *this;
+        }
+
+        // the cache this sprite is stored in or NULL
+        cCol_Rect_Cache* m_cache;
+        // slot number in the cache
+        unsigned int m_slot;
+    };
+
+    /* *** *** *** *** *** *** *** cCol_Rect_Cache *** *** *** *** *** *** *** *** *** *** */
+
+    /* Copy of the sprite collision rects as separate x, y, width and height
+     * arrays so that a query rect can be tested against several of them
+     * at once with SSE2 or AVX.
+     * Sprites keep their slot until removed and must update it whenever
+     * their collision rect changes or they get destroyed.
+     */
+    class cCol_Rect_Cache {
+    public:
+        cCol_Rect_Cache(void);
+        ~cCol_Rect_Cache(void);
+
+        // Store the sprite
+        void Insert(cSprite* sprite);
+        // Remove the sprite
+        void Remove(cSprite* sprite);
+        // Copy the current collision rect and destroyed state of the sprite
+        void Update(const cSprite* sprite);
+        // Remove all sprites
+        void Clear(void);
+
+        /* Add the slots of all not destroyed sprites whose collision rect
+         * intersects the given rect like GL_rect::Intersects() to the list
+         * the slots are added in ascending order
+        */
+        void Query(vector<unsigned int>& result, const GL_rect& rect) const;
+
+        // Return the sprite in the given slot
+        inline cSprite* Get_Sprite(unsigned int slot) const
+        {
+            return m_sprites[slot];
+        };
+
+        // Return the number of stored sprites
+        inline size_t size(void) const
+        {
+            return m_count;
+        };
+
+        // slots tested by one kernel step, the arrays are padded to it
+        static const unsigned int m_batch_size;
+        // about as many rects are tested in the time of one spatial hash cell lookup
+        static const unsigned int m_cell_lookup_cost;
+
+    private:
+        // Set the slot to a rect which never intersects and mark it as unused
+        void Clear_Slot(unsigned int slot);
+
+        vector<float> m_x;
+        vector<float> m_y;
+        vector<float> m_w;
+        vector<float> m_h;
+        // if the slot is used by a not destroyed sprite
+        vector<unsigned char> m_usable;
+        // NULL if unused
+        vector<cSprite*> m_sprites;
+        // unused slots below the used size
+        vector<unsigned int> m_free_slots;
+        // slots up to the last used one
+        unsigned int m_used_size;
+        // stored sprite count
+        size_t m_count;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
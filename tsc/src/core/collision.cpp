@@ -27,7 +27,7 @@ namespace TSC {
 /* *** *** *** *** *** *** *** cObjectCollisionType *** *** *** *** *** *** *** *** *** *** */
 
 cObjectCollisionType::cObjectCollisionType(void)
-    : cObject_Manager<cObjectCollision>()
+    : cObject_Manager<cObjectCollision, cObjectCollision_Allocator>()
 {
 
 }
@@ -43,7 +43,7 @@ void cObjectCollisionType::Add(cObjectCollision* obj)
         return;
     }
 
-    cObject_Manager<cObjectCollision>::Add(obj);
+    cObject_Manager<cObjectCollision, cObjectCollision_Allocator>::Add(obj);
 }
 
 // check if sprite
@@ -22,6 +22,7 @@
 #include "../core/global_basic.hpp"
 #include "../core/global_game.hpp"
 #include "../core/obj_manager.hpp"
+#include "../core/memory_pool.hpp"
 #include "../core/math/rect.hpp"
 #include "math/circle.hpp"
 
@@ -35,6 +36,16 @@ namespace TSC {
         cObjectCollision(void);
         ~cObjectCollision(void);
 
+        // collision data is created and deleted many times per frame
+        static inline void* operator new(size_t size)
+        {
+            return cSmall_Object_Pool::Allocate(size);
+        }
+        static inline void operator delete(void* ptr, size_t size)
+        {
+            cSmall_Object_Pool::Free(ptr, size);
+        }
+
         /* Set the collision direction
          * base - the base sprite
          * col - the colliding sprite
@@ -60,16 +71,27 @@ namespace TSC {
         ArrayType m_array;
     };
 
-    typedef vector<cObjectCollision*> cObjectCollision_List;
+    typedef cPool_Allocator<cObjectCollision*> cObjectCollision_Allocator;
+    typedef vector<cObjectCollision*, cObjectCollision_Allocator> cObjectCollision_List;
 
     /* *** *** *** *** *** *** *** cObjectCollisionType *** *** *** *** *** *** *** *** *** *** */
 
 // collision type class
-    class cObjectCollisionType : public cObject_Manager<cObjectCollision> {
+    class cObjectCollisionType : public cObject_Manager<cObjectCollision, cObjectCollision_Allocator> {
     public:
         cObjectCollisionType(void);
         virtual ~cObjectCollisionType(void);
 
+        // collision lists are created and deleted for every collision check
+        static inline void* operator new(size_t size)
+        {
+            return cSmall_Object_Pool::Allocate(size);
+        }
+        static inline void operator delete(void* ptr, size_t size)
+        {
+            cSmall_Object_Pool::Free(ptr, size);
+        }
+
         // Add an object collision
         virtual void Add(cObjectCollision* obj);
 
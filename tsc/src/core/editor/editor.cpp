@@ -1305,7 +1305,7 @@ void cEditor::Process_Input(void)
     }
 
     // Camera Movement
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) || pJoystick->Right()) {
+    if (pKeyboard->Is_Key_Pressed(sf::Keyboard::Right) || pJoystick->Right()) {
         if (pKeyboard->Is_Shift_Down()) {
             pActive_Camera->Move(CAMERA_SPEED * pFramerate->m_speed_factor * 3 * pPreferences->m_scroll_speed, 0.0f);
         }
@@ -1313,7 +1313,7 @@ void cEditor::Process_Input(void)
             pActive_Camera->Move(CAMERA_SPEED * pFramerate->m_speed_factor * pPreferences->m_scroll_speed, 0.0f);
         }
     }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) || pJoystick->Left()) {
+    else if (pKeyboard->Is_Key_Pressed(sf::Keyboard::Left) || pJoystick->Left()) {
         if (pKeyboard->Is_Shift_Down()) {
             pActive_Camera->Move(-(CAMERA_SPEED * pFramerate->m_speed_factor * 3 * pPreferences->m_scroll_speed), 0.0f);
         }
@@ -1321,7 +1321,7 @@ void cEditor::Process_Input(void)
             pActive_Camera->Move(-(CAMERA_SPEED * pFramerate->m_speed_factor * pPreferences->m_scroll_speed), 0.0f);
         }
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up) || pJoystick->Up()) {
+    if (pKeyboard->Is_Key_Pressed(sf::Keyboard::Up) || pJoystick->Up()) {
         if (pKeyboard->Is_Shift_Down()) {
             pActive_Camera->Move(0.0f, -(CAMERA_SPEED * pFramerate->m_speed_factor * 3 * pPreferences->m_scroll_speed));
         }
@@ -1329,7 +1329,7 @@ void cEditor::Process_Input(void)
             pActive_Camera->Move(0.0f, -(CAMERA_SPEED * pFramerate->m_speed_factor * pPreferences->m_scroll_speed));
         }
     }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down) || pJoystick->Down()) {
+    else if (pKeyboard->Is_Key_Pressed(sf::Keyboard::Down) || pJoystick->Down()) {
         if (pKeyboard->Is_Shift_Down()) {
             pActive_Camera->Move(0.0f, CAMERA_SPEED * pFramerate->m_speed_factor * 3 * pPreferences->m_scroll_speed);
         }
@@ -38,6 +38,7 @@ void cPerformance_Timer::Reset(void)
     frame_counter = 0;
     ms_counter = 0;
     ms = 0;
+    count = 0;
 }
 
 void cPerformance_Timer::Update(void)
@@ -58,6 +59,11 @@ void cPerformance_Timer::Update(void)
     }
 }
 
+void cPerformance_Timer::Set_Count(uint32_t new_count)
+{
+    count = new_count;
+}
+
 
 /* *** *** *** *** *** *** cFramerate *** *** *** *** *** *** *** *** *** *** *** */
 
@@ -78,7 +84,7 @@ cFramerate::cFramerate(void)
     m_perf_last_ticks = 0;
 
     // create performance timers
-    for (unsigned int i = 0; i < 24; i++) {
+    for (unsigned int i = 0; i < 28; i++) {
         m_perf_timer.push_back(new cPerformance_Timer());
     }
 }
@@ -34,6 +34,8 @@ namespace TSC {
 
         // Update and set new framerate ticks
         void Update(void);
+        // Set the count of the current frame for timers counting items instead of time
+        void Set_Count(uint32_t new_count);
 
         // current frame counter
         uint32_t frame_counter;
@@ -41,6 +43,8 @@ namespace TSC {
         uint32_t ms_counter;
         // milliseconds per 100 frames
         uint32_t ms;
+        // count of the last frame
+        uint32_t count;
     };
 
     /* *** *** *** *** *** *** *** cFramerate *** *** *** *** *** *** *** *** *** *** */
@@ -61,6 +61,7 @@ const int game_res_h = 600;
 
 bool game_debug = 0;
 bool game_debug_performance = 0;
+bool game_headless = 0;
 
 sf::Event input_event;
 
@@ -49,6 +49,8 @@ namespace TSC {
 // global debugging
     extern bool game_debug;
     extern bool game_debug_performance;
+// no window, OpenGL context or input devices are used
+    extern bool game_headless;
 
 // Game Input event
     extern sf::Event input_event;
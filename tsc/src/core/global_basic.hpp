@@ -22,11 +22,6 @@
 #define _WIN32_IE 0x0500
 #endif
 
-/* uncomment to enable experimental rendering in a thread
-* still randomly crashes because gl functions are called while the render thread is active
-*/
-//#define TSC_RENDER_THREAD_TEST
-
 /* *** *** *** *** *** *** *** Debugging *** *** *** *** *** *** *** *** *** *** */
 
 #if defined(_MSC_VER) && defined(_DEBUG)
@@ -48,6 +43,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <climits>
+#include <cfloat>
 #include <cctype>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -93,6 +89,9 @@
 // None, True, and False that screw CEGUI declarations.
 #include <CEGUI/CEGUI.h>
 #include <CEGUI/RendererModules/OpenGL/GLRenderer.h>
+#ifdef ENABLE_HEADLESS
+#include <CEGUI/RendererModules/Null/Renderer.h>
+#endif
 
 // SFML
 // Must also be included before X11, which has a #define Status int that messes
@@ -400,7 +400,13 @@ namespace TSC {
         // rendering
         PERF_RENDER_GAME = 13,
         PERF_RENDER_GUI = 20,
-        PERF_RENDER_BUFFER = 21
+        PERF_RENDER_BUFFER = 21,
+        // draw calls of the game render queue
+        PERF_RENDER_GAME_DRAW_CALLS = 26,
+        PERF_RENDER_GAME_OPAQUE_DRAW_CALLS = 27,
+        // collision broad phase counts
+        PERF_COLLISION_PAIRS_TESTED = 24,
+        PERF_COLLISION_PAIRS_FOUND = 25
     };
 
     /* *** Classes *** */
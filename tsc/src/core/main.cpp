@@ -23,6 +23,7 @@
 #include "../level/level.hpp"
 #include "../gui/menu.hpp"
 #include "../core/framerate.hpp"
+#include "../core/math/random.hpp"
 #include "../user/preferences.hpp"
 #include "../audio/sound_manager.hpp"
 #include "../audio/audio.hpp"
@@ -38,6 +39,7 @@
 #include "../user/savegame/savegame.hpp"
 #include "../input/keyboard.hpp"
 #include "../video/renderer.hpp"
+#include "../video/particle_budget.hpp"
 #include "../video/loading_screen.hpp"
 #include "../video/img_settings.hpp"
 #include "../video/img_manager.hpp"
@@ -111,6 +113,9 @@ int main(int argc, char** argv)
                 cout << "-l, --level\tLoad the given level" << endl;
                 cout << "-w, --world\tLoad the given world" << endl;
                 cout << "-p, --package\tLoad the given package" << endl;
+#ifdef ENABLE_HEADLESS
+                cout << "--headless\tRun without a window, OpenGL and input devices" << endl;
+#endif
                 return EXIT_SUCCESS;
             }
             // version
@@ -157,6 +162,12 @@ int main(int argc, char** argv)
                 if (i + 1 < arguments.size())
                     g_cmdline_package = arguments[i + 1];
             }
+#ifdef ENABLE_HEADLESS
+            // headless
+            else if (arguments[i] == "--headless") {
+                game_headless = 1;
+            }
+#endif
             // level loading is handled later
             else if (arguments[i] == "--level" || arguments[i] == "-l") {
                 // skip
@@ -210,11 +221,7 @@ int main(int argc, char** argv)
             Draw_Game();
 
             // render
-#ifdef TSC_RENDER_THREAD_TEST
-            pVideo->Render(1);
-#else
-            pVideo->Render();
-#endif
+            pVideo->Render(pPreferences->m_video_render_thread);
 
             // update speedfactor
             pFramerate->Update();
@@ -235,8 +242,9 @@ namespace TSC {
 
 void Init_Game(void)
 {
-    // init random number generator
+    // init random number generators
     srand(static_cast<unsigned int>(time(NULL)));
+    game_random.Seed(static_cast<uint64_t>(time(NULL)));
 
     // Init Stage 1 - core classes
     debug_print("Initializing resource manager and core classes\n");
@@ -245,6 +253,7 @@ void Init_Game(void)
     pVideo = new cVideo();
     pAudio = new cAudio();
     pFramerate = new cFramerate();
+    pParticle_Budget = new cParticle_Budget();
     pRenderer = new cRenderQueue(200);
     pRenderer_current = new cRenderQueue(200);
     pImage_Manager = new cImage_Manager();
@@ -337,6 +346,11 @@ void Init_Game(void)
 
 void Exit_Game(void)
 {
+    // the context is needed to delete the textures
+    if (pVideo) {
+        pVideo->Render_Finish();
+    }
+
     if (pPreferences) {
         pPreferences->Save();
     }
@@ -456,6 +470,11 @@ void Exit_Game(void)
         pSettingsParser = NULL;
     }
 
+    if (pParticle_Budget) {
+        delete pParticle_Budget;
+        pParticle_Budget = NULL;
+    }
+
     if (pPackage_Manager) {
         delete pPackage_Manager;
         pPackage_Manager = NULL;
@@ -605,6 +624,9 @@ void Update_Game(void)
     // performance measuring
     pFramerate->m_perf_last_ticks = TSC_GetTicks();
 
+    // ## particle budget from the last frame
+    pParticle_Budget->Update();
+
     // ## hud
     gp_hud->Update();
 
@@ -0,0 +1,77 @@
+/***************************************************************************
+ * random.cpp - Fast seedable random number generator
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../../core/math/random.hpp"
+
+using namespace std;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** cRandom_Generator *** *** *** *** *** *** *** *** *** *** */
+
+cRandom_Generator::cRandom_Generator(uint64_t seed /* = 0 */, uint64_t stream /* = 0 */)
+{
+    Seed(seed, stream);
+}
+
+void cRandom_Generator::Seed(uint64_t seed, uint64_t stream /* = 0 */)
+{
+    m_state = 0;
+    m_increment = (stream << 1u) | 1u;
+    Get_Uint32();
+    m_state += seed;
+    Get_Uint32();
+}
+
+void cRandom_Generator::Get_Floats(float* values, unsigned int count)
+{
+    // keep the state in a register for the loop
+    uint64_t state = m_state;
+    const uint64_t increment = m_increment;
+
+    for (unsigned int i = 0; i < count; i++) {
+        const uint64_t old_state = state;
+        state = old_state * 6364136223846793005ULL + increment;
+
+        const uint32_t xorshifted = static_cast<uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+        const uint32_t rot = static_cast<uint32_t>(old_state >> 59u);
+        const uint32_t value = (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+
+        values[i] = static_cast<float>(value >> 8) * (1.0f / 16777216.0f);
+    }
+
+    m_state = state;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+uint32_t Get_Random_Seed(const std::string& text)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+
+    for (std::string::const_iterator itr = text.begin(); itr != text.end(); ++itr) {
+        hash ^= static_cast<uint8_t>(*itr);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+cRandom_Generator game_random;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,84 @@
+/***************************************************************************
+ * random.hpp - Fast seedable random number generator
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_RANDOM_HPP
+#define TSC_RANDOM_HPP
+
+#include "../../core/global_basic.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** cRandom_Generator *** *** *** *** *** *** *** *** *** *** */
+
+    /* PCG32 generator from pcg-random.org
+     * Unlike rand() it has no global state and lock, so every user can own one
+     * and the same seed always gives the same values on every platform.
+     * Generators with the same seed but another stream give other values.
+     */
+    class cRandom_Generator {
+    public:
+        cRandom_Generator(uint64_t seed = 0, uint64_t stream = 0);
+
+        // Restart with the given seed and stream
+        void Seed(uint64_t seed, uint64_t stream = 0);
+
+        // Return a random value
+        inline uint32_t Get_Uint32(void)
+        {
+            const uint64_t old_state = m_state;
+            m_state = old_state * 6364136223846793005ULL + m_increment;
+
+            const uint32_t xorshifted = static_cast<uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+            const uint32_t rot = static_cast<uint32_t>(old_state >> 59u);
+            return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+        }
+        // Return a random value from 0 to the given maximum ( exclusive )
+        inline uint32_t Get_Uint32(uint32_t max)
+        {
+            return static_cast<uint32_t>((static_cast<uint64_t>(Get_Uint32()) * max) >> 32);
+        }
+        // Return a random value from 0.0 to 1.0 ( exclusive )
+        inline float Get_Float(void)
+        {
+            // 24 bits fit exactly into the float mantissa
+            return static_cast<float>(Get_Uint32() >> 8) * (1.0f / 16777216.0f);
+        }
+        // Return a random value between the given values
+        inline float Get_Float(float min, float max)
+        {
+            return min + ((max - min) * Get_Float());
+        }
+        // Fill the array with random values from 0.0 to 1.0 ( exclusive )
+        void Get_Floats(float* values, unsigned int count);
+
+    private:
+        uint64_t m_state;
+        // odd and selects the stream
+        uint64_t m_increment;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Return a seed from the text which is the same on every platform
+    uint32_t Get_Random_Seed(const std::string& text);
+
+// Generator for everything without its own, seeded in Init_Game
+    extern cRandom_Generator game_random;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
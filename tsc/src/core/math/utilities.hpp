@@ -19,6 +19,7 @@
 
 #include "../../core/global_basic.hpp"
 #include "../../core/global_game.hpp"
+#include "../../core/math/random.hpp"
 
 namespace TSC {
 
@@ -39,7 +40,7 @@ namespace TSC {
 // return a random floating point value between the given values
     inline float Get_Random_Float(float min, float max)
     {
-        return min + (max - min) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+        return game_random.Get_Float(min, max);
     }
 
 // Checks if number is power of 2 and if not returns the next power of two size
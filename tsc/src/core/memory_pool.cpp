@@ -0,0 +1,79 @@
+/***************************************************************************
+ * memory_pool.cpp - Free list pool for small short-lived objects
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/memory_pool.hpp"
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** cSmall_Object_Pool *** *** *** *** *** *** *** *** *** *** */
+
+cSmall_Object_Pool::Free_Item* cSmall_Object_Pool::m_free_lists[cSmall_Object_Pool::m_max_size / cSmall_Object_Pool::m_size_step] = {NULL};
+
+void* cSmall_Object_Pool::Allocate(size_t size)
+{
+    // not pooled
+    if (size == 0 || size > m_max_size) {
+        return ::operator new(size);
+    }
+
+    const size_t size_class = (size - 1) / m_size_step;
+
+    if (!m_free_lists[size_class]) {
+        Refill(size_class);
+    }
+
+    Free_Item* item = m_free_lists[size_class];
+    m_free_lists[size_class] = item->m_next;
+
+    return item;
+}
+
+void cSmall_Object_Pool::Free(void* ptr, size_t size)
+{
+    if (!ptr) {
+        return;
+    }
+
+    // not pooled
+    if (size == 0 || size > m_max_size) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    const size_t size_class = (size - 1) / m_size_step;
+
+    Free_Item* item = static_cast<Free_Item*>(ptr);
+    item->m_next = m_free_lists[size_class];
+    m_free_lists[size_class] = item;
+}
+
+void cSmall_Object_Pool::Refill(size_t size_class)
+{
+    const size_t item_size = (size_class + 1) * m_size_step;
+    const size_t item_count = m_block_size / item_size;
+
+    // blocks are never freed as items from them may be in use until exit
+    char* block = static_cast<char*>(::operator new(item_count * item_size));
+
+    for (size_t i = 0; i < item_count; i++) {
+        Free_Item* item = reinterpret_cast<Free_Item*>(block + i * item_size);
+        item->m_next = m_free_lists[size_class];
+        m_free_lists[size_class] = item;
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,100 @@
+/***************************************************************************
+ * memory_pool.hpp - Free list pool for small short-lived objects
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_MEMORY_POOL_HPP
+#define TSC_MEMORY_POOL_HPP
+
+#include "../core/global_basic.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** cSmall_Object_Pool *** *** *** *** *** *** *** *** *** *** */
+
+    /* Size class free lists for small objects which are created and
+     * deleted many times per frame like collision data.
+     * Freed memory is kept for the next allocation of the same size class
+     * and only returned to the system at exit, so once the peak usage
+     * was reached no further general heap allocations happen.
+     * Bigger requests are passed to the default allocator.
+     * Not thread safe, only use it from the main thread.
+     */
+    class cSmall_Object_Pool {
+    public:
+        // Return memory for the given size
+        static void* Allocate(size_t size);
+        // Give back memory returned by Allocate() with the same size
+        static void Free(void* ptr, size_t size);
+
+        // size class step and maximum pooled size
+        static const size_t m_size_step = 16;
+        static const size_t m_max_size = 512;
+        // memory block size the size classes are filled from
+        static const size_t m_block_size = 64 * 1024;
+
+    private:
+        struct Free_Item {
+            Free_Item* m_next;
+        };
+
+        // Fill the free list of the given size class
+        static void Refill(size_t size_class);
+
+        // one free list per size class
+        static Free_Item* m_free_lists[m_max_size / m_size_step];
+    };
+
+    /* *** *** *** *** *** *** *** cPool_Allocator *** *** *** *** *** *** *** *** *** *** */
+
+    /* Standard container allocator using the small object pool
+     * small containers like collision lists then keep their memory
+     * in the pool instead of the general heap
+     */
+    template<class T> class cPool_Allocator {
+    public:
+        typedef T value_type;
+
+        cPool_Allocator(void) {}
+        template<class U> cPool_Allocator(const cPool_Allocator<U>&) {}
+
+        inline T* allocate(size_t count)
+        {
+            return static_cast<T*>(cSmall_Object_Pool::Allocate(count * sizeof(T)));
+        }
+
+        inline void deallocate(T* ptr, size_t count)
+        {
+            cSmall_Object_Pool::Free(ptr, count * sizeof(T));
+        }
+
+        template<class U> struct rebind {
+            typedef cPool_Allocator<U> other;
+        };
+    };
+
+    template<class T, class U> inline bool operator == (const cPool_Allocator<T>&, const cPool_Allocator<U>&)
+    {
+        return 1;
+    }
+
+    template<class T, class U> inline bool operator != (const cPool_Allocator<T>&, const cPool_Allocator<U>&)
+    {
+        return 0;
+    }
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
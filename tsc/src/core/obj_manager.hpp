@@ -23,7 +23,10 @@ namespace TSC {
 
     /* *** *** *** *** *** cObject_Manager *** *** *** *** *** *** *** *** *** *** *** *** */
 
-    template<class T> class cObject_Manager {
+    /* Object pointer container
+     * Alloc : allocator of the objects array
+    */
+    template<class T, class Alloc = std::allocator<T*> > class cObject_Manager {
     public:
         cObject_Manager(void) {};
         virtual ~cObject_Manager(void) {};
@@ -58,7 +61,7 @@ namespace TSC {
             }
 
             // get iterator
-            typename vector<T*>::iterator itr = std::find(objects.begin(), objects.end(), obj);
+            typename vector<T*, Alloc>::iterator itr = std::find(objects.begin(), objects.end(), obj);
 
             // available in vector
             if (itr != objects.end()) {
@@ -76,7 +79,7 @@ namespace TSC {
         // Delete all objects
         virtual void Delete_All(void)
         {
-            for (typename vector<T*>::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+            for (typename vector<T*, Alloc>::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
                 delete *itr;
             }
 
@@ -110,14 +113,14 @@ namespace TSC {
                 return 0;
             }
 
-            typename vector<T*>::iterator itr1 = std::find(objects.begin(), objects.end(), obj1);
+            typename vector<T*, Alloc>::iterator itr1 = std::find(objects.begin(), objects.end(), obj1);
 
             // not in vector
             if (itr1 == objects.end()) {
                 return 0;
             }
 
-            typename vector<T*>::iterator itr2 = std::find(objects.begin(), objects.end(), obj2);
+            typename vector<T*, Alloc>::iterator itr2 = std::find(objects.begin(), objects.end(), obj2);
 
             // not in vector
             if (itr2 == objects.end()) {
@@ -141,7 +144,7 @@ namespace TSC {
                 return -1;
             }
 
-            typename vector<T*>::const_iterator itr_obj = std::find(objects.begin(), objects.end(), obj);
+            typename vector<T*, Alloc>::const_iterator itr_obj = std::find(objects.begin(), objects.end(), obj);
 
             // not in vector
             if (itr_obj == objects.end()) {
@@ -163,7 +166,7 @@ namespace TSC {
             return objects.empty();
         }
 
-        vector<T*> objects;
+        vector<T*, Alloc> objects;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
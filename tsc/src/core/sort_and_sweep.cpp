@@ -0,0 +1,562 @@
+/***************************************************************************
+ * sort_and_sweep.cpp - Per frame broad phase for sprite collisions
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/sort_and_sweep.hpp"
+#include "../core/spatial_hash.hpp"
+#include "../core/framerate.hpp"
+#include "../core/math/rect.hpp"
+#include "../objects/movingsprite.hpp"
+
+namespace TSC {
+
+/* *** *** *** *** *** *** cSort_And_Sweep *** *** *** *** *** *** *** *** *** *** *** */
+
+const unsigned int cSort_And_Sweep::m_pending_item = UINT_MAX;
+const unsigned int cSort_And_Sweep::m_max_sorted_inserts = 64;
+const unsigned int cSort_And_Sweep::m_max_stale_sprites = 64;
+
+// added to the bounds of moving sprites to allow float differences in the movement rect
+static const float sort_and_sweep_move_margin = 1.0f;
+
+cSort_And_Sweep::cSort_And_Sweep(void)
+{
+    m_pairs_tested = 0;
+    m_pairs_found = 0;
+    m_count = 0;
+    m_update_stamp = 0;
+    m_valid = 0;
+}
+
+cSort_And_Sweep::~cSort_And_Sweep(void)
+{
+    Clear();
+}
+
+void cSort_And_Sweep::Update(const vector<cSprite*>& sprites)
+{
+    m_update_stamp++;
+    m_pairs_tested = 0;
+    m_new_sprites.clear();
+
+    // stale sprites from the last frame are updated normally
+    for (vector<cSprite*>::iterator itr = m_stale_sprites.begin(); itr != m_stale_sprites.end(); ++itr) {
+        const cSort_And_Sweep_Entry& entry = (*itr)->m_broad_phase_entry;
+
+        if (entry.m_item != m_pending_item) {
+            m_items[entry.m_item].m_stale = 0;
+        }
+    }
+
+    m_stale_sprites.clear();
+
+    // mark the stored sprites and find the new ones
+    for (vector<cSprite*>::const_iterator itr = sprites.begin(); itr != sprites.end(); ++itr) {
+        cSprite* obj = (*itr);
+
+        // destroyed
+        if (obj->m_auto_destroy) {
+            continue;
+        }
+
+        cSort_And_Sweep_Entry& entry = obj->m_broad_phase_entry;
+
+        if (entry.m_broad_phase == this && entry.m_item != m_pending_item) {
+            m_items[entry.m_item].m_update_stamp = m_update_stamp;
+            continue;
+        }
+
+        // stored in another broad phase
+        if (entry.m_broad_phase && entry.m_broad_phase != this) {
+            entry.m_broad_phase->Remove(obj);
+        }
+
+        m_new_sprites.push_back(obj);
+    }
+
+    // remove sprites which are not available anymore
+    for (unsigned int i = 0; i < m_items.size(); i++) {
+        if (m_items[i].m_sprite && m_items[i].m_update_stamp != m_update_stamp) {
+            Remove_Item(i);
+        }
+    }
+
+    // drop the endpoints of removed items before their numbers are used again
+    if (!m_removed_items.empty()) {
+        vector<Endpoint>::iterator endpoint_end = m_endpoints.begin();
+
+        for (vector<Endpoint>::iterator itr = m_endpoints.begin(); itr != m_endpoints.end(); ++itr) {
+            if (m_items[itr->m_item].m_sprite) {
+                *endpoint_end++ = *itr;
+            }
+        }
+
+        m_endpoints.erase(endpoint_end, m_endpoints.end());
+        m_free_items.insert(m_free_items.end(), m_removed_items.begin(), m_removed_items.end());
+        m_removed_items.clear();
+    }
+
+    for (vector<Item>::iterator itr = m_items.begin(); itr != m_items.end(); ++itr) {
+        if (itr->m_sprite) {
+            Update_Bounds(*itr);
+        }
+    }
+
+    // add new sprites
+    for (vector<cSprite*>::iterator itr = m_new_sprites.begin(); itr != m_new_sprites.end(); ++itr) {
+        cSprite* obj = (*itr);
+        unsigned int item_num;
+
+        if (m_free_items.empty()) {
+            item_num = m_items.size();
+            m_items.push_back(Item());
+        }
+        else {
+            item_num = m_free_items.back();
+            m_free_items.pop_back();
+        }
+
+        Item& item = m_items[item_num];
+        item.m_sprite = obj;
+        item.m_update_stamp = m_update_stamp;
+        item.m_moving = dynamic_cast<cMovingSprite*>(obj) != NULL;
+        item.m_stale = 0;
+        item.m_pairs.clear();
+        Update_Bounds(item);
+        item.m_changed = 1;
+
+        obj->m_broad_phase_entry.m_broad_phase = this;
+        obj->m_broad_phase_entry.m_item = item_num;
+
+        Endpoint endpoint;
+        endpoint.m_item = item_num;
+        endpoint.m_max = 0;
+        m_endpoints.push_back(endpoint);
+        endpoint.m_max = 1;
+        m_endpoints.push_back(endpoint);
+
+        m_count++;
+    }
+
+    // set the new endpoint positions
+    for (vector<Endpoint>::iterator itr = m_endpoints.begin(); itr != m_endpoints.end(); ++itr) {
+        const Item& item = m_items[itr->m_item];
+        itr->m_value = itr->m_max ? item.m_right : item.m_left;
+    }
+
+    // the order barely changes between frames
+    if (m_new_sprites.size() > m_max_sorted_inserts) {
+        Rebuild_Pairs();
+    }
+    else {
+        Sort_Endpoints();
+    }
+
+    m_new_sprites.clear();
+
+    // only pairs with changed bounds need a new y axis test
+    for (unsigned int i = 0; i < m_items.size(); i++) {
+        const Item& item = m_items[i];
+
+        if (!item.m_sprite || !item.m_changed) {
+            continue;
+        }
+
+        for (vector<Pair_Link>::const_iterator itr = item.m_pairs.begin(); itr != item.m_pairs.end(); ++itr) {
+            // test pairs of two changed items only once
+            if (m_items[itr->m_item].m_changed && itr->m_item < i) {
+                continue;
+            }
+
+            Test_Pair(i, itr->m_item);
+        }
+    }
+
+    m_valid = 1;
+}
+
+void cSort_And_Sweep::Remove(cSprite* sprite)
+{
+    if (!sprite) {
+        return;
+    }
+
+    cSort_And_Sweep_Entry& entry = sprite->m_broad_phase_entry;
+
+    // not stored here
+    if (entry.m_broad_phase != this) {
+        return;
+    }
+
+    if (entry.m_item == m_pending_item || m_items[entry.m_item].m_stale) {
+        vector<cSprite*>::iterator itr = std::find(m_stale_sprites.begin(), m_stale_sprites.end(), sprite);
+
+        if (itr != m_stale_sprites.end()) {
+            m_stale_sprites.erase(itr);
+        }
+    }
+
+    if (entry.m_item != m_pending_item) {
+        Remove_Item(entry.m_item);
+    }
+
+    entry.m_broad_phase = NULL;
+}
+
+void cSort_And_Sweep::Clear(void)
+{
+    for (vector<Item>::iterator itr = m_items.begin(); itr != m_items.end(); ++itr) {
+        if (itr->m_sprite) {
+            itr->m_sprite->m_broad_phase_entry.m_broad_phase = NULL;
+        }
+    }
+
+    for (vector<cSprite*>::iterator itr = m_stale_sprites.begin(); itr != m_stale_sprites.end(); ++itr) {
+        (*itr)->m_broad_phase_entry.m_broad_phase = NULL;
+    }
+
+    m_items.clear();
+    m_free_items.clear();
+    m_removed_items.clear();
+    m_endpoints.clear();
+    m_stale_sprites.clear();
+    m_new_sprites.clear();
+    m_active_items.clear();
+
+    m_pairs_tested = 0;
+    m_pairs_found = 0;
+    m_count = 0;
+    m_valid = 0;
+}
+
+void cSort_And_Sweep::Add_Pending(cSprite* sprite)
+{
+    // not used or already stored
+    if (!m_valid || sprite->m_broad_phase_entry.m_broad_phase) {
+        return;
+    }
+
+    sprite->m_broad_phase_entry.m_broad_phase = this;
+    sprite->m_broad_phase_entry.m_item = m_pending_item;
+    m_stale_sprites.push_back(sprite);
+
+    // too many to check with every query
+    if (m_stale_sprites.size() > m_max_stale_sprites) {
+        m_valid = 0;
+    }
+}
+
+void cSort_And_Sweep::Check_Bounds(cSprite* sprite)
+{
+    const cSort_And_Sweep_Entry& entry = sprite->m_broad_phase_entry;
+
+    if (!m_valid || entry.m_broad_phase != this || entry.m_item == m_pending_item) {
+        return;
+    }
+
+    Item& item = m_items[entry.m_item];
+
+    // already known
+    if (item.m_stale) {
+        return;
+    }
+
+    float left, top, right, bottom;
+    cSpatial_Hash::Get_Collision_Bounds(sprite->m_col_rect, left, top, right, bottom);
+
+    // still inside
+    if (left >= item.m_left && top >= item.m_top && right <= item.m_right && bottom <= item.m_bottom) {
+        return;
+    }
+
+    item.m_stale = 1;
+    m_stale_sprites.push_back(sprite);
+
+    // too many to check with every query
+    if (m_stale_sprites.size() > m_max_stale_sprites) {
+        m_valid = 0;
+    }
+}
+
+bool cSort_And_Sweep::Is_Usable(const cSprite* sprite, const GL_rect& rect) const
+{
+    if (!m_valid || !sprite) {
+        return 0;
+    }
+
+    const cSort_And_Sweep_Entry& entry = sprite->m_broad_phase_entry;
+
+    if (entry.m_broad_phase != this || entry.m_item == m_pending_item) {
+        return 0;
+    }
+
+    const Item& item = m_items[entry.m_item];
+
+    // only moving sprites have all their pairs
+    if (!item.m_moving || item.m_stale) {
+        return 0;
+    }
+
+    float left, top, right, bottom;
+    cSpatial_Hash::Get_Query_Bounds(rect, left, top, right, bottom);
+
+    return left >= item.m_left && top >= item.m_top && right <= item.m_right && bottom <= item.m_bottom;
+}
+
+void cSort_And_Sweep::Get_Pairs(vector<cSprite*>& result, const cSprite* sprite) const
+{
+    const Item& item = m_items[sprite->m_broad_phase_entry.m_item];
+
+    for (vector<Pair_Link>::const_iterator itr = item.m_pairs.begin(); itr != item.m_pairs.end(); ++itr) {
+        if (!itr->m_overlapping) {
+            continue;
+        }
+
+        const Item& other = m_items[itr->m_item];
+
+        // added below
+        if (other.m_stale) {
+            continue;
+        }
+
+        result.push_back(other.m_sprite);
+    }
+
+    // could be anywhere
+    result.insert(result.end(), m_stale_sprites.begin(), m_stale_sprites.end());
+}
+
+void cSort_And_Sweep::Update_Bounds(Item& item)
+{
+    float left, top, right, bottom;
+    cSpatial_Hash::Get_Collision_Bounds(item.m_sprite->m_col_rect, left, top, right, bottom);
+
+    // include the movement of this frame
+    if (item.m_moving) {
+        const cMovingSprite* moving_sprite = static_cast<const cMovingSprite*>(item.m_sprite);
+        const float move_x = moving_sprite->m_velx * pFramerate->m_speed_factor;
+        const float move_y = moving_sprite->m_vely * pFramerate->m_speed_factor;
+
+        if (move_x > 0.0f) {
+            right += move_x;
+        }
+        else {
+            left += move_x;
+        }
+
+        if (move_y > 0.0f) {
+            bottom += move_y;
+        }
+        else {
+            top += move_y;
+        }
+
+        left -= sort_and_sweep_move_margin;
+        top -= sort_and_sweep_move_margin;
+        right += sort_and_sweep_move_margin;
+        bottom += sort_and_sweep_move_margin;
+    }
+
+    item.m_changed = left != item.m_left || top != item.m_top || right != item.m_right || bottom != item.m_bottom;
+    item.m_left = left;
+    item.m_top = top;
+    item.m_right = right;
+    item.m_bottom = bottom;
+}
+
+void cSort_And_Sweep::Remove_Item(unsigned int item_num)
+{
+    Item& item = m_items[item_num];
+
+    while (!item.m_pairs.empty()) {
+        Remove_Pair(item_num, item.m_pairs.back().m_item);
+    }
+
+    item.m_sprite->m_broad_phase_entry.m_broad_phase = NULL;
+    item.m_sprite = NULL;
+    item.m_stale = 0;
+
+    // the endpoints are removed with the next update
+    m_removed_items.push_back(item_num);
+    m_count--;
+}
+
+void cSort_And_Sweep::Add_Pair(unsigned int item_a, unsigned int item_b)
+{
+    if (item_a == item_b) {
+        return;
+    }
+
+    Item& a = m_items[item_a];
+    Item& b = m_items[item_b];
+
+    // both can not move
+    if (!a.m_moving && !b.m_moving) {
+        return;
+    }
+
+    // search the shorter list
+    const vector<Pair_Link>& search = a.m_pairs.size() < b.m_pairs.size() ? a.m_pairs : b.m_pairs;
+    const unsigned int search_item = a.m_pairs.size() < b.m_pairs.size() ? item_b : item_a;
+
+    for (vector<Pair_Link>::const_iterator itr = search.begin(); itr != search.end(); ++itr) {
+        // already available
+        if (itr->m_item == search_item) {
+            return;
+        }
+    }
+
+    // the y axis is tested after sorting
+    Pair_Link link;
+    link.m_overlapping = 0;
+
+    link.m_item = item_b;
+    a.m_pairs.push_back(link);
+    link.m_item = item_a;
+    b.m_pairs.push_back(link);
+}
+
+void cSort_And_Sweep::Remove_Pair(unsigned int item_a, unsigned int item_b)
+{
+    vector<Pair_Link>& pairs_a = m_items[item_a].m_pairs;
+    vector<Pair_Link>& pairs_b = m_items[item_b].m_pairs;
+
+    for (vector<Pair_Link>::iterator itr = pairs_a.begin(); itr != pairs_a.end(); ++itr) {
+        if (itr->m_item != item_b) {
+            continue;
+        }
+
+        if (itr->m_overlapping) {
+            m_pairs_found--;
+        }
+
+        *itr = pairs_a.back();
+        pairs_a.pop_back();
+        break;
+    }
+
+    for (vector<Pair_Link>::iterator itr = pairs_b.begin(); itr != pairs_b.end(); ++itr) {
+        if (itr->m_item != item_a) {
+            continue;
+        }
+
+        *itr = pairs_b.back();
+        pairs_b.pop_back();
+        break;
+    }
+}
+
+void cSort_And_Sweep::Test_Pair(unsigned int item_a, unsigned int item_b)
+{
+    Item& a = m_items[item_a];
+    Item& b = m_items[item_b];
+
+    m_pairs_tested++;
+
+    const bool overlapping = !(a.m_top > b.m_bottom || a.m_bottom < b.m_top);
+
+    for (vector<Pair_Link>::iterator itr = a.m_pairs.begin(); itr != a.m_pairs.end(); ++itr) {
+        if (itr->m_item != item_b) {
+            continue;
+        }
+
+        // not changed
+        if (itr->m_overlapping == overlapping) {
+            return;
+        }
+
+        itr->m_overlapping = overlapping;
+        break;
+    }
+
+    for (vector<Pair_Link>::iterator itr = b.m_pairs.begin(); itr != b.m_pairs.end(); ++itr) {
+        if (itr->m_item == item_a) {
+            itr->m_overlapping = overlapping;
+            break;
+        }
+    }
+
+    if (overlapping) {
+        m_pairs_found++;
+    }
+    else {
+        m_pairs_found--;
+    }
+}
+
+void cSort_And_Sweep::Rebuild_Pairs(void)
+{
+    for (vector<Item>::iterator itr = m_items.begin(); itr != m_items.end(); ++itr) {
+        itr->m_pairs.clear();
+        itr->m_changed = 1;
+    }
+
+    m_pairs_found = 0;
+
+    std::sort(m_endpoints.begin(), m_endpoints.end(), endpoint_sort());
+
+    // every item overlaps with the items still active at its left side
+    m_active_items.clear();
+
+    for (vector<Endpoint>::const_iterator itr = m_endpoints.begin(); itr != m_endpoints.end(); ++itr) {
+        if (itr->m_max) {
+            vector<unsigned int>::iterator active_itr = std::find(m_active_items.begin(), m_active_items.end(), itr->m_item);
+
+            if (active_itr != m_active_items.end()) {
+                *active_itr = m_active_items.back();
+                m_active_items.pop_back();
+            }
+
+            continue;
+        }
+
+        for (vector<unsigned int>::const_iterator active_itr = m_active_items.begin(); active_itr != m_active_items.end(); ++active_itr) {
+            Add_Pair(itr->m_item, *active_itr);
+        }
+
+        m_active_items.push_back(itr->m_item);
+    }
+
+    m_active_items.clear();
+}
+
+void cSort_And_Sweep::Sort_Endpoints(void)
+{
+    for (size_t i = 1; i < m_endpoints.size(); i++) {
+        const Endpoint endpoint = m_endpoints[i];
+        size_t j = i;
+
+        while (j > 0 && Endpoint_Less(endpoint, m_endpoints[j - 1])) {
+            const Endpoint& other = m_endpoints[j - 1];
+
+            // a left side moved over a right side : starts overlapping
+            if (!endpoint.m_max && other.m_max) {
+                Add_Pair(endpoint.m_item, other.m_item);
+            }
+            // a right side moved over a left side : stops overlapping
+            else if (endpoint.m_max && !other.m_max) {
+                Remove_Pair(endpoint.m_item, other.m_item);
+            }
+
+            m_endpoints[j] = other;
+            j--;
+        }
+
+        m_endpoints[j] = endpoint;
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,196 @@
+/***************************************************************************
+ * sort_and_sweep.hpp - Per frame broad phase for sprite collisions
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_SORT_AND_SWEEP_HPP
+#define TSC_SORT_AND_SWEEP_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
+
+namespace TSC {
+
+    class cSort_And_Sweep;
+
+    /* *** *** *** *** *** *** *** cSort_And_Sweep_Entry *** *** *** *** *** *** *** *** *** *** */
+
+    /* The broad phase item a sprite is stored as.
+     * Copying a sprite never copies the registration.
+     */
+    class cSort_And_Sweep_Entry {
+    public:
+        cSort_And_Sweep_Entry(void)
+            : m_broad_phase(NULL), m_item(0) {}
+        cSort_And_Sweep_Entry(const cSort_And_Sweep_Entry&)
+            : m_broad_phase(NULL), m_item(0) {}
+
+        inline cSort_And_Sweep_Entry& operator = (const cSort_And_Sweep_Entry&)
+        {
+            return *this;
+        }
+
+        // the broad phase this sprite is stored in or NULL
+        cSort_And_Sweep* m_broad_phase;
+        // item number or m_pending_item if added during the frame
+        unsigned int m_item;
+    };
+
+    /* *** *** *** *** *** *** *** cSort_And_Sweep *** *** *** *** *** *** *** *** *** *** */
+
+    /* Sort and sweep broad phase on the x axis.
+     * Updated once per frame before the collision handling. The item bounds
+     * of moving sprites include their movement of this frame so that their
+     * collision checks only need to look at their pairs.
+     * The endpoints are kept sorted between frames and only moved with an
+     * insertion sort, which also adds and removes the overlapping pairs.
+     * Pairs of two sprites which can not move are never stored.
+     *
+     * Sprites leaving their bounds or added during the frame are returned
+     * with every pair query until the next update.
+     */
+    class cSort_And_Sweep {
+    public:
+        cSort_And_Sweep(void);
+        ~cSort_And_Sweep(void);
+
+        /* Update the items and pairs from the given sprites
+         * stored sprites which are not in the list anymore are removed
+        */
+        void Update(const vector<cSprite*>& sprites);
+        // Remove the sprite
+        void Remove(cSprite* sprite);
+        // Remove all sprites
+        void Clear(void);
+
+        // Add a sprite created after the last update
+        void Add_Pending(cSprite* sprite);
+        // Check if the sprite left its stored bounds
+        void Check_Bounds(cSprite* sprite);
+        // Stop using the pairs until the next update
+        inline void Invalidate(void)
+        {
+            m_valid = 0;
+        }
+
+        // Check if the pairs of the sprite contain every sprite touching the given rect
+        bool Is_Usable(const cSprite* sprite, const GL_rect& rect) const;
+        /* Add all sprites paired with the given sprite to the list
+         * every sprite is only added once but in no specific order
+        */
+        void Get_Pairs(vector<cSprite*>& result, const cSprite* sprite) const;
+
+        // Return the number of stored sprites
+        inline size_t size(void) const
+        {
+            return m_count;
+        };
+
+        // item number of sprites added during the frame
+        static const unsigned int m_pending_item;
+        // more new items than this are added with a full sort
+        static const unsigned int m_max_sorted_inserts;
+        // more sprites leaving their bounds than this invalidate the pairs
+        static const unsigned int m_max_stale_sprites;
+
+        // pair overlap tests done in the last update
+        unsigned int m_pairs_tested;
+        // overlapping pairs after the last update
+        unsigned int m_pairs_found;
+
+    private:
+        struct Pair_Link {
+            // the other item
+            unsigned int m_item;
+            // if the bounds also overlap on the y axis
+            bool m_overlapping;
+        };
+
+        struct Item {
+            float m_left, m_top, m_right, m_bottom;
+            // NULL if removed
+            cSprite* m_sprite;
+            // last update which found the sprite
+            unsigned int m_update_stamp;
+            // a sprite which can move
+            bool m_moving;
+            // bounds changed in this update
+            bool m_changed;
+            // left its bounds in this frame
+            bool m_stale;
+            // items overlapping on the x axis
+            vector<Pair_Link> m_pairs;
+        };
+
+        struct Endpoint {
+            float m_value;
+            unsigned int m_item;
+            // right side of the item
+            bool m_max;
+        };
+
+        // Endpoint sort, left sides first at the same value so that touching bounds overlap
+        static inline bool Endpoint_Less(const Endpoint& a, const Endpoint& b)
+        {
+            return a.m_value < b.m_value || (a.m_value == b.m_value && !a.m_max && b.m_max);
+        }
+
+        struct endpoint_sort {
+            bool operator()(const Endpoint& a, const Endpoint& b) const
+            {
+                return Endpoint_Less(a, b);
+            }
+        };
+
+        // Set the item bounds from its sprite
+        void Update_Bounds(Item& item);
+        // Remove the item and its pairs
+        void Remove_Item(unsigned int item_num);
+        // Add the items as a pair if not already
+        void Add_Pair(unsigned int item_a, unsigned int item_b);
+        // Remove the pair if available
+        void Remove_Pair(unsigned int item_a, unsigned int item_b);
+        // Test the y axis of the pair and set the overlapping state on both sides
+        void Test_Pair(unsigned int item_a, unsigned int item_b);
+        // Sort all endpoints and find all pairs again
+        void Rebuild_Pairs(void);
+        // Move the endpoints to their sorted position and update the pairs
+        void Sort_Endpoints(void);
+
+        vector<Item> m_items;
+        // removed item numbers which can be used again
+        vector<unsigned int> m_free_items;
+        // items removed since the last update, their endpoints are still stored
+        vector<unsigned int> m_removed_items;
+        // item sides sorted on the x axis
+        vector<Endpoint> m_endpoints;
+        // sprites returned with every pair query
+        vector<cSprite*> m_stale_sprites;
+        // temporary update list of new sprites
+        vector<cSprite*> m_new_sprites;
+        // temporary list of active items while sweeping
+        vector<unsigned int> m_active_items;
+
+        // stored sprite count
+        size_t m_count;
+        // current update
+        unsigned int m_update_stamp;
+        // if the pairs are usable
+        bool m_valid;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
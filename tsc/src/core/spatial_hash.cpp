@@ -0,0 +1,372 @@
+/***************************************************************************
+ * spatial_hash.cpp - Uniform grid for sprite collision queries
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/spatial_hash.hpp"
+#include "../core/math/rect.hpp"
+#include "../core/math/circle.hpp"
+#include "../objects/sprite.hpp"
+
+namespace TSC {
+
+/* *** *** *** *** *** *** cSpatial_Hash *** *** *** *** *** *** *** *** *** *** *** */
+
+const float cSpatial_Hash::m_default_cell_size = 128.0f;
+const int cSpatial_Hash::m_max_cells_per_sprite = 256;
+
+// cell coordinates are clamped to this to stay inside an int
+static const float max_cell_coord = 1000000000.0f;
+
+cSpatial_Hash::cSpatial_Hash(float cell_size /* = m_default_cell_size */)
+{
+    m_cell_size = m_default_cell_size;
+    m_cell_size_inv = 1.0f / m_cell_size;
+    m_count = 0;
+    m_query_stamp = 0;
+
+    Set_Cell_Size(cell_size);
+}
+
+cSpatial_Hash::~cSpatial_Hash(void)
+{
+    Clear();
+}
+
+void cSpatial_Hash::Set_Cell_Size(float cell_size)
+{
+    // invalid
+    if (cell_size < 1.0f) {
+        cell_size = m_default_cell_size;
+    }
+
+    if (Is_Float_Equal(cell_size, m_cell_size) && m_count) {
+        return;
+    }
+
+    // get all registered sprites
+    vector<cSprite*> sprites = m_oversized;
+
+    for (CellMap::const_iterator itr = m_cells.begin(); itr != m_cells.end(); ++itr) {
+        sprites.insert(sprites.end(), itr->second.begin(), itr->second.end());
+    }
+
+    std::sort(sprites.begin(), sprites.end());
+    sprites.erase(std::unique(sprites.begin(), sprites.end()), sprites.end());
+
+    Clear();
+
+    m_cell_size = cell_size;
+    m_cell_size_inv = 1.0f / m_cell_size;
+
+    // register again with the new cells
+    for (vector<cSprite*>::iterator itr = sprites.begin(); itr != sprites.end(); ++itr) {
+        Insert(*itr);
+    }
+}
+
+void cSpatial_Hash::Insert(cSprite* sprite)
+{
+    if (!sprite) {
+        return;
+    }
+
+    cSpatial_Hash_Entry& entry = sprite->m_spatial_hash_entry;
+
+    // already registered
+    if (entry.m_hash == this) {
+        Update(sprite);
+        return;
+    }
+    // registered in another hash
+    else if (entry.m_hash) {
+        entry.m_hash->Remove(sprite);
+    }
+
+    Get_Cell_Range(sprite, entry.m_x0, entry.m_y0, entry.m_x1, entry.m_y1);
+    Link(sprite, entry);
+
+    entry.m_hash = this;
+    entry.m_query_stamp = 0;
+    m_count++;
+}
+
+void cSpatial_Hash::Remove(cSprite* sprite)
+{
+    if (!sprite) {
+        return;
+    }
+
+    cSpatial_Hash_Entry& entry = sprite->m_spatial_hash_entry;
+
+    // not registered here
+    if (entry.m_hash != this) {
+        return;
+    }
+
+    Unlink(sprite, entry);
+
+    entry.m_hash = NULL;
+    m_count--;
+}
+
+void cSpatial_Hash::Update(cSprite* sprite)
+{
+    cSpatial_Hash_Entry& entry = sprite->m_spatial_hash_entry;
+
+    // not registered here
+    if (entry.m_hash != this) {
+        return;
+    }
+
+    int x0, y0, x1, y1;
+    Get_Cell_Range(sprite, x0, y0, x1, y1);
+
+    // still in the same cells
+    if (x0 == entry.m_x0 && y0 == entry.m_y0 && x1 == entry.m_x1 && y1 == entry.m_y1) {
+        return;
+    }
+
+    Unlink(sprite, entry);
+
+    entry.m_x0 = x0;
+    entry.m_y0 = y0;
+    entry.m_x1 = x1;
+    entry.m_y1 = y1;
+
+    Link(sprite, entry);
+}
+
+void cSpatial_Hash::Clear(void)
+{
+    for (CellMap::iterator itr = m_cells.begin(); itr != m_cells.end(); ++itr) {
+        for (vector<cSprite*>::iterator sprite_itr = itr->second.begin(); sprite_itr != itr->second.end(); ++sprite_itr) {
+            (*sprite_itr)->m_spatial_hash_entry.m_hash = NULL;
+        }
+    }
+
+    for (vector<cSprite*>::iterator itr = m_oversized.begin(); itr != m_oversized.end(); ++itr) {
+        (*itr)->m_spatial_hash_entry.m_hash = NULL;
+    }
+
+    m_cells.clear();
+    m_oversized.clear();
+    m_count = 0;
+}
+
+void cSpatial_Hash::Query(vector<cSprite*>& result, const GL_rect& rect) const
+{
+    float left, top, right, bottom;
+    Get_Query_Bounds(rect, left, top, right, bottom);
+
+    Query_Cells(result, left, top, right, bottom);
+}
+
+void cSpatial_Hash::Query(vector<cSprite*>& result, const GL_Circle& circle) const
+{
+    float left, top, right, bottom;
+    Get_Query_Bounds(circle, left, top, right, bottom);
+
+    Query_Cells(result, left, top, right, bottom);
+}
+
+uint64_t cSpatial_Hash::Get_Query_Cell_Count(const GL_rect& rect) const
+{
+    float left, top, right, bottom;
+    Get_Query_Bounds(rect, left, top, right, bottom);
+
+    const uint64_t columns = static_cast<uint64_t>(static_cast<int64_t>(Get_Cell_Coord(right)) - Get_Cell_Coord(left) + 1);
+    const uint64_t rows = static_cast<uint64_t>(static_cast<int64_t>(Get_Cell_Coord(bottom)) - Get_Cell_Coord(top) + 1);
+
+    return columns * rows;
+}
+
+void cSpatial_Hash::Get_Collision_Bounds(const GL_rect& rect, float& left, float& top, float& right, float& bottom)
+{
+    Get_Query_Bounds(rect, left, top, right, bottom);
+
+    /* include the circle Col_Circle() uses for this rect
+     * it reaches out of thin rects
+    */
+    const float radius = (fabs(rect.m_w) + fabs(rect.m_h)) / 4;
+    const float middle_x = (left + right) * 0.5f;
+    const float middle_y = (top + bottom) * 0.5f;
+
+    left = std::min(left, middle_x - radius);
+    right = std::max(right, middle_x + radius);
+    top = std::min(top, middle_y - radius);
+    bottom = std::max(bottom, middle_y + radius);
+}
+
+void cSpatial_Hash::Get_Query_Bounds(const GL_rect& rect, float& left, float& top, float& right, float& bottom)
+{
+    left = rect.m_x;
+    right = rect.m_x + rect.m_w;
+    top = rect.m_y;
+    bottom = rect.m_y + rect.m_h;
+
+    if (right < left) {
+        std::swap(left, right);
+    }
+    if (bottom < top) {
+        std::swap(top, bottom);
+    }
+}
+
+void cSpatial_Hash::Get_Query_Bounds(const GL_Circle& circle, float& left, float& top, float& right, float& bottom)
+{
+    // Col_Circle() allows a distance of 1 between the circles
+    const float radius = fabs(circle.Get_Radius()) + 1.0f;
+
+    left = circle.Get_X() - radius;
+    top = circle.Get_Y() - radius;
+    right = circle.Get_X() + radius;
+    bottom = circle.Get_Y() + radius;
+}
+
+int cSpatial_Hash::Get_Cell_Coord(float pos) const
+{
+    float cell = floor(pos * m_cell_size_inv);
+
+    // also catches NaN
+    if (!(cell > -max_cell_coord)) {
+        return static_cast<int>(-max_cell_coord);
+    }
+    if (cell > max_cell_coord) {
+        return static_cast<int>(max_cell_coord);
+    }
+
+    return static_cast<int>(cell);
+}
+
+void cSpatial_Hash::Get_Cell_Range(const cSprite* sprite, int& x0, int& y0, int& x1, int& y1) const
+{
+    float left, top, right, bottom;
+    Get_Collision_Bounds(sprite->m_col_rect, left, top, right, bottom);
+
+    x0 = Get_Cell_Coord(left);
+    y0 = Get_Cell_Coord(top);
+    x1 = Get_Cell_Coord(right);
+    y1 = Get_Cell_Coord(bottom);
+}
+
+void cSpatial_Hash::Link(cSprite* sprite, cSpatial_Hash_Entry& entry)
+{
+    const long cell_count = (static_cast<long>(entry.m_x1) - entry.m_x0 + 1) * (static_cast<long>(entry.m_y1) - entry.m_y0 + 1);
+
+    // too big for the grid
+    if (cell_count > m_max_cells_per_sprite) {
+        entry.m_oversized = 1;
+        m_oversized.push_back(sprite);
+        return;
+    }
+
+    entry.m_oversized = 0;
+
+    for (int x = entry.m_x0; x <= entry.m_x1; x++) {
+        for (int y = entry.m_y0; y <= entry.m_y1; y++) {
+            m_cells[Get_Key(x, y)].push_back(sprite);
+        }
+    }
+}
+
+void cSpatial_Hash::Unlink(cSprite* sprite, cSpatial_Hash_Entry& entry)
+{
+    if (entry.m_oversized) {
+        vector<cSprite*>::iterator itr = std::find(m_oversized.begin(), m_oversized.end(), sprite);
+
+        if (itr != m_oversized.end()) {
+            *itr = m_oversized.back();
+            m_oversized.pop_back();
+        }
+
+        return;
+    }
+
+    for (int x = entry.m_x0; x <= entry.m_x1; x++) {
+        for (int y = entry.m_y0; y <= entry.m_y1; y++) {
+            CellMap::iterator cell_itr = m_cells.find(Get_Key(x, y));
+
+            // not available
+            if (cell_itr == m_cells.end()) {
+                continue;
+            }
+
+            vector<cSprite*>& cell = cell_itr->second;
+            vector<cSprite*>::iterator itr = std::find(cell.begin(), cell.end(), sprite);
+
+            if (itr != cell.end()) {
+                *itr = cell.back();
+                cell.pop_back();
+            }
+
+            // don't keep cells of the whole travelled path
+            if (cell.empty()) {
+                m_cells.erase(cell_itr);
+            }
+        }
+    }
+}
+
+void cSpatial_Hash::Query_Cells(vector<cSprite*>& result, float left, float top, float right, float bottom) const
+{
+    m_query_stamp++;
+
+    // wrapped around : old stamps could match again
+    if (m_query_stamp == 0) {
+        for (CellMap::const_iterator itr = m_cells.begin(); itr != m_cells.end(); ++itr) {
+            for (vector<cSprite*>::const_iterator sprite_itr = itr->second.begin(); sprite_itr != itr->second.end(); ++sprite_itr) {
+                (*sprite_itr)->m_spatial_hash_entry.m_query_stamp = 0;
+            }
+        }
+
+        m_query_stamp = 1;
+    }
+
+    // oversized sprites are always candidates
+    result.insert(result.end(), m_oversized.begin(), m_oversized.end());
+
+    const int x0 = Get_Cell_Coord(left);
+    const int y0 = Get_Cell_Coord(top);
+    const int x1 = Get_Cell_Coord(right);
+    const int y1 = Get_Cell_Coord(bottom);
+
+    for (int x = x0; x <= x1; x++) {
+        for (int y = y0; y <= y1; y++) {
+            CellMap::const_iterator cell_itr = m_cells.find(Get_Key(x, y));
+
+            // empty cell
+            if (cell_itr == m_cells.end()) {
+                continue;
+            }
+
+            const vector<cSprite*>& cell = cell_itr->second;
+
+            for (vector<cSprite*>::const_iterator itr = cell.begin(); itr != cell.end(); ++itr) {
+                cSprite* obj = (*itr);
+
+                // already added from another cell
+                if (obj->m_spatial_hash_entry.m_query_stamp == m_query_stamp) {
+                    continue;
+                }
+
+                obj->m_spatial_hash_entry.m_query_stamp = m_query_stamp;
+                result.push_back(obj);
+            }
+        }
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
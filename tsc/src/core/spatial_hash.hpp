@@ -0,0 +1,154 @@
+/***************************************************************************
+ * spatial_hash.hpp - Uniform grid for sprite collision queries
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_SPATIAL_HASH_HPP
+#define TSC_SPATIAL_HASH_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
+
+namespace TSC {
+
+    class cSpatial_Hash;
+    class GL_Circle;
+
+    /* *** *** *** *** *** *** *** cSpatial_Hash_Entry *** *** *** *** *** *** *** *** *** *** */
+
+    /* The cell range a sprite is registered with in a cSpatial_Hash.
+     * It lives inside the sprite so that position updates do not need
+     * a lookup. Copying a sprite never copies the registration.
+     */
+    class cSpatial_Hash_Entry {
+    public:
+        cSpatial_Hash_Entry(void)
+            : m_hash(NULL), m_x0(0), m_y0(0), m_x1(-1), m_y1(-1), m_oversized(0), m_query_stamp(0) {}
+        cSpatial_Hash_Entry(const cSpatial_Hash_Entry&)
+            : m_hash(NULL), m_x0(0), m_y0(0), m_x1(-1), m_y1(-1), m_oversized(0), m_query_stamp(0) {}
+
+        inline cSpatial_Hash_Entry& operator = (const cSpatial_Hash_Entry&)
+        {
+            return *this;
+        }
+
+        // the hash this sprite is registered in or NULL
+        cSpatial_Hash* m_hash;
+        // registered cell range ( inclusive )
+        int m_x0, m_y0;
+        int m_x1, m_y1;
+        // if set the sprite is too big for the grid and kept in a separate list
+        bool m_oversized;
+        // last query which returned this sprite
+        unsigned int m_query_stamp;
+    };
+
+    /* *** *** *** *** *** *** *** cSpatial_Hash *** *** *** *** *** *** *** *** *** *** */
+
+    /* Uniform grid of square cells mapping world positions to the sprites
+     * whose collision rect touches them. Only cells which contain sprites
+     * are allocated, so the level size does not matter.
+     *
+     * Each sprite is registered with the bounding box of its collision rect
+     * and of the circle Col_Circle() approximates for it, so that both rect
+     * and circle queries only need to look at the cells they touch.
+     * Queries return candidates only, the caller still has to do the exact
+     * intersection test.
+     */
+    class cSpatial_Hash {
+    public:
+        cSpatial_Hash(float cell_size = m_default_cell_size);
+        ~cSpatial_Hash(void);
+
+        /* Set the cell size
+         * all registered sprites are inserted again
+        */
+        void Set_Cell_Size(float cell_size);
+        // Return the cell size
+        inline float Get_Cell_Size(void) const
+        {
+            return m_cell_size;
+        };
+
+        // Register the sprite with its current collision rect
+        void Insert(cSprite* sprite);
+        // Unregister the sprite
+        void Remove(cSprite* sprite);
+        // Move the sprite to the cells of its current collision rect
+        void Update(cSprite* sprite);
+        // Unregister all sprites
+        void Clear(void);
+
+        /* Add all sprites which could touch the given rect/circle to the list
+         * every sprite is only added once but in no specific order
+        */
+        void Query(vector<cSprite*>& result, const GL_rect& rect) const;
+        void Query(vector<cSprite*>& result, const GL_Circle& circle) const;
+
+        // Return the number of cells a query with the given rect looks at
+        uint64_t Get_Query_Cell_Count(const GL_rect& rect) const;
+
+        // Return the number of registered sprites
+        inline size_t size(void) const
+        {
+            return m_count;
+        };
+
+        /* Calculate the area a collision rect can collide in
+         * this is the rect and the circle Col_Circle() approximates for it
+        */
+        static void Get_Collision_Bounds(const GL_rect& rect, float& left, float& top, float& right, float& bottom);
+        // Calculate the area to check for the given rect/circle query
+        static void Get_Query_Bounds(const GL_rect& rect, float& left, float& top, float& right, float& bottom);
+        static void Get_Query_Bounds(const GL_Circle& circle, float& left, float& top, float& right, float& bottom);
+
+        // default cell size ( two times the common tile size )
+        static const float m_default_cell_size;
+        // sprites spanning more cells are not stored in the grid
+        static const int m_max_cells_per_sprite;
+
+    private:
+        typedef std::unordered_map<uint64_t, vector<cSprite*> > CellMap;
+
+        // Return the cell coordinate for the given world coordinate
+        int Get_Cell_Coord(float pos) const;
+        // Return the hash key for the given cell
+        static inline uint64_t Get_Key(int x, int y)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+        };
+        // Calculate the cell range for the given sprite
+        void Get_Cell_Range(const cSprite* sprite, int& x0, int& y0, int& x1, int& y1) const;
+        // Add/Remove the sprite to/from the cells of the given entry
+        void Link(cSprite* sprite, cSpatial_Hash_Entry& entry);
+        void Unlink(cSprite* sprite, cSpatial_Hash_Entry& entry);
+        // Add all sprites of the given cell range to the result
+        void Query_Cells(vector<cSprite*>& result, float left, float top, float right, float bottom) const;
+
+        float m_cell_size;
+        float m_cell_size_inv;
+
+        CellMap m_cells;
+        // sprites too big for the grid
+        vector<cSprite*> m_oversized;
+        // registered sprite count
+        size_t m_count;
+        // current query identifier used to add each sprite only once
+        mutable unsigned int m_query_stamp;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
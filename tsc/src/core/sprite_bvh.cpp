@@ -0,0 +1,257 @@
+/***************************************************************************
+ * sprite_bvh.cpp - Bounding volume hierarchy for static sprites
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/sprite_bvh.hpp"
+#include "../core/math/rect.hpp"
+#include "../core/math/circle.hpp"
+#include "../objects/sprite.hpp"
+
+namespace TSC {
+
+/* *** *** *** *** *** *** cSprite_BVH *** *** *** *** *** *** *** *** *** *** *** */
+
+const unsigned int cSprite_BVH::m_max_leaf_items = 4;
+
+// maximum tree depth while querying, the median split keeps the tree balanced
+static const unsigned int bvh_max_query_depth = 64;
+
+cSprite_BVH::cSprite_BVH(cSpatial_Hash* dynamic_hash /* = NULL */)
+{
+    m_dynamic_hash = dynamic_hash;
+    m_count = 0;
+}
+
+cSprite_BVH::~cSprite_BVH(void)
+{
+    Clear();
+}
+
+void cSprite_BVH::Build(const vector<cSprite*>& sprites)
+{
+    Clear();
+
+    if (sprites.empty()) {
+        return;
+    }
+
+    m_items.reserve(sprites.size());
+
+    for (vector<cSprite*>::const_iterator itr = sprites.begin(); itr != sprites.end(); ++itr) {
+        cSprite* obj = (*itr);
+
+        // already in a tree
+        if (obj->m_static_tree_entry.m_bvh) {
+            obj->m_static_tree_entry.m_bvh->Remove(obj);
+        }
+
+        Item item;
+        cSpatial_Hash::Get_Collision_Bounds(obj->m_col_rect, item.m_left, item.m_top, item.m_right, item.m_bottom);
+        item.m_sprite = obj;
+
+        m_items.push_back(item);
+    }
+
+    // a balanced binary tree has less than two nodes per item
+    m_nodes.reserve(2 * m_items.size() / m_max_leaf_items + 1);
+    m_nodes.resize(1);
+    Build_Node(0, 0, m_items.size());
+
+    // set the final item numbers
+    for (unsigned int i = 0; i < m_items.size(); i++) {
+        cSprite_BVH_Entry& entry = m_items[i].m_sprite->m_static_tree_entry;
+
+        entry.m_bvh = this;
+        entry.m_item = i;
+    }
+
+    m_count = m_items.size();
+}
+
+void cSprite_BVH::Remove(cSprite* sprite)
+{
+    if (!sprite) {
+        return;
+    }
+
+    cSprite_BVH_Entry& entry = sprite->m_static_tree_entry;
+
+    // not stored here
+    if (entry.m_bvh != this) {
+        return;
+    }
+
+    // the tree is immutable, only the item is cleared
+    m_items[entry.m_item].m_sprite = NULL;
+
+    entry.m_bvh = NULL;
+    m_count--;
+}
+
+void cSprite_BVH::Promote(cSprite* sprite)
+{
+    Remove(sprite);
+
+    if (m_dynamic_hash) {
+        m_dynamic_hash->Insert(sprite);
+    }
+}
+
+void cSprite_BVH::Clear(void)
+{
+    for (vector<Item>::iterator itr = m_items.begin(); itr != m_items.end(); ++itr) {
+        if (itr->m_sprite) {
+            itr->m_sprite->m_static_tree_entry.m_bvh = NULL;
+        }
+    }
+
+    m_items.clear();
+    m_nodes.clear();
+    m_count = 0;
+}
+
+bool cSprite_BVH::Is_Inside(const cSprite* sprite) const
+{
+    const cSprite_BVH_Entry& entry = sprite->m_static_tree_entry;
+
+    // not stored here
+    if (entry.m_bvh != this) {
+        return 0;
+    }
+
+    float left, top, right, bottom;
+    cSpatial_Hash::Get_Collision_Bounds(sprite->m_col_rect, left, top, right, bottom);
+
+    const Item& item = m_items[entry.m_item];
+
+    return left >= item.m_left && top >= item.m_top && right <= item.m_right && bottom <= item.m_bottom;
+}
+
+void cSprite_BVH::Query(vector<cSprite*>& result, const GL_rect& rect) const
+{
+    float left, top, right, bottom;
+    cSpatial_Hash::Get_Query_Bounds(rect, left, top, right, bottom);
+
+    Query_Nodes(result, left, top, right, bottom);
+}
+
+void cSprite_BVH::Query(vector<cSprite*>& result, const GL_Circle& circle) const
+{
+    float left, top, right, bottom;
+    cSpatial_Hash::Get_Query_Bounds(circle, left, top, right, bottom);
+
+    Query_Nodes(result, left, top, right, bottom);
+}
+
+void cSprite_BVH::Build_Node(unsigned int node_num, unsigned int first, unsigned int count)
+{
+    Node node;
+    node.m_left = m_items[first].m_left;
+    node.m_top = m_items[first].m_top;
+    node.m_right = m_items[first].m_right;
+    node.m_bottom = m_items[first].m_bottom;
+
+    // item centers are compared doubled
+    float center_left = m_items[first].m_left + m_items[first].m_right;
+    float center_right = center_left;
+    float center_top = m_items[first].m_top + m_items[first].m_bottom;
+    float center_bottom = center_top;
+
+    for (unsigned int i = first + 1; i < first + count; i++) {
+        const Item& item = m_items[i];
+
+        node.m_left = std::min(node.m_left, item.m_left);
+        node.m_top = std::min(node.m_top, item.m_top);
+        node.m_right = std::max(node.m_right, item.m_right);
+        node.m_bottom = std::max(node.m_bottom, item.m_bottom);
+
+        center_left = std::min(center_left, item.m_left + item.m_right);
+        center_right = std::max(center_right, item.m_left + item.m_right);
+        center_top = std::min(center_top, item.m_top + item.m_bottom);
+        center_bottom = std::max(center_bottom, item.m_top + item.m_bottom);
+    }
+
+    // leaf
+    if (count <= m_max_leaf_items) {
+        node.m_first = first;
+        node.m_count = count;
+        m_nodes[node_num] = node;
+        return;
+    }
+
+    // split at the median of the longer axis
+    const bool vertical = center_bottom - center_top > center_right - center_left;
+    const unsigned int half = count / 2;
+
+    std::nth_element(m_items.begin() + first, m_items.begin() + first + half, m_items.begin() + first + count, item_center_sort(vertical));
+
+    node.m_first = m_nodes.size();
+    node.m_count = 0;
+    m_nodes[node_num] = node;
+
+    // both children are next to each other
+    m_nodes.resize(m_nodes.size() + 2);
+
+    Build_Node(node.m_first, first, half);
+    Build_Node(node.m_first + 1, first + half, count - half);
+}
+
+void cSprite_BVH::Query_Nodes(vector<cSprite*>& result, float left, float top, float right, float bottom) const
+{
+    if (m_nodes.empty() || !m_count) {
+        return;
+    }
+
+    unsigned int stack[bvh_max_query_depth];
+    unsigned int stack_size = 0;
+
+    stack[stack_size++] = 0;
+
+    while (stack_size) {
+        const Node& node = m_nodes[stack[--stack_size]];
+
+        // not touching
+        if (node.m_left > right || node.m_right < left || node.m_top > bottom || node.m_bottom < top) {
+            continue;
+        }
+
+        // inner node
+        if (!node.m_count) {
+            // too deep
+            if (stack_size + 2 > bvh_max_query_depth) {
+                debug_print("Sprite BVH too deep for query\n");
+                continue;
+            }
+
+            stack[stack_size++] = node.m_first + 1;
+            stack[stack_size++] = node.m_first;
+            continue;
+        }
+
+        for (unsigned int i = node.m_first; i < node.m_first + node.m_count; i++) {
+            const Item& item = m_items[i];
+
+            // removed or not touching
+            if (!item.m_sprite || item.m_left > right || item.m_right < left || item.m_top > bottom || item.m_bottom < top) {
+                continue;
+            }
+
+            result.push_back(item.m_sprite);
+        }
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,143 @@
+/***************************************************************************
+ * sprite_bvh.hpp - Bounding volume hierarchy for static sprites
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_SPRITE_BVH_HPP
+#define TSC_SPRITE_BVH_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
+#include "../core/spatial_hash.hpp"
+
+namespace TSC {
+
+    class cSprite_BVH;
+
+    /* *** *** *** *** *** *** *** cSprite_BVH_Entry *** *** *** *** *** *** *** *** *** *** */
+
+    /* The tree item a static sprite is stored in.
+     * Copying a sprite never copies the registration.
+     */
+    class cSprite_BVH_Entry {
+    public:
+        cSprite_BVH_Entry(void)
+            : m_bvh(NULL), m_item(0) {}
+        cSprite_BVH_Entry(const cSprite_BVH_Entry&)
+            : m_bvh(NULL), m_item(0) {}
+
+        inline cSprite_BVH_Entry& operator = (const cSprite_BVH_Entry&)
+        {
+            return *this;
+        }
+
+        // the tree this sprite is stored in or NULL
+        cSprite_BVH* m_bvh;
+        // item number in the tree
+        unsigned int m_item;
+    };
+
+    /* *** *** *** *** *** *** *** cSprite_BVH *** *** *** *** *** *** *** *** *** *** */
+
+    /* Immutable bounding volume hierarchy for sprites which do not move.
+     * It is built once after the level is loaded and sprites can only be
+     * removed afterwards. A sprite leaving its stored bounds is promoted
+     * to the given dynamic spatial hash.
+     * Queries return candidates only, the caller still has to do the exact
+     * intersection test.
+     */
+    class cSprite_BVH {
+    public:
+        cSprite_BVH(cSpatial_Hash* dynamic_hash = NULL);
+        ~cSprite_BVH(void);
+
+        /* Build the tree from the given sprites
+         * all previously stored sprites are removed
+        */
+        void Build(const vector<cSprite*>& sprites);
+        // Remove the sprite from the tree
+        void Remove(cSprite* sprite);
+        // Remove the sprite from the tree and insert it into the dynamic spatial hash
+        void Promote(cSprite* sprite);
+        // Remove all sprites
+        void Clear(void);
+
+        // Check if the collision rect of the stored sprite is still inside its tree bounds
+        bool Is_Inside(const cSprite* sprite) const;
+
+        /* Add all sprites which could touch the given rect/circle to the list
+         * every sprite is only added once but in no specific order
+        */
+        void Query(vector<cSprite*>& result, const GL_rect& rect) const;
+        void Query(vector<cSprite*>& result, const GL_Circle& circle) const;
+
+        // Return the number of stored sprites
+        inline size_t size(void) const
+        {
+            return m_count;
+        };
+
+        // maximum sprites in a leaf node
+        static const unsigned int m_max_leaf_items;
+
+    private:
+        struct Item {
+            float m_left, m_top, m_right, m_bottom;
+            // NULL if removed
+            cSprite* m_sprite;
+        };
+
+        struct Node {
+            float m_left, m_top, m_right, m_bottom;
+            // first item if leaf or first of both child nodes
+            unsigned int m_first;
+            // item count if leaf or 0
+            unsigned int m_count;
+        };
+
+        // Item center sort on the given axis
+        struct item_center_sort {
+            item_center_sort(bool vertical) : m_vertical(vertical) {}
+
+            bool operator()(const Item& a, const Item& b) const
+            {
+                if (m_vertical) {
+                    return a.m_top + a.m_bottom < b.m_top + b.m_bottom;
+                }
+
+                return a.m_left + a.m_right < b.m_left + b.m_right;
+            }
+
+            bool m_vertical;
+        };
+
+        // Build the given node from the given items
+        void Build_Node(unsigned int node_num, unsigned int first, unsigned int count);
+        // Add all sprites touching the given bounds to the result
+        void Query_Nodes(vector<cSprite*>& result, float left, float top, float right, float bottom) const;
+
+        // promotion target
+        cSpatial_Hash* m_dynamic_hash;
+
+        vector<Item> m_items;
+        // the first node is the root
+        vector<Node> m_nodes;
+        // stored sprite count
+        size_t m_count;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
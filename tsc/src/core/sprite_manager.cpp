@@ -20,6 +20,7 @@
 #include "../input/mouse.hpp"
 #include "../overworld/world_player.hpp"
 #include "../enemies/enemy.hpp"
+#include "../core/framerate.hpp"
 #include "../core/global_basic.hpp"
 
 using namespace std;
@@ -28,12 +29,14 @@ namespace TSC {
 
 /* *** *** *** *** *** *** cSprite_Manager *** *** *** *** *** *** *** *** *** *** *** */
 
-cSprite_Manager::cSprite_Manager(unsigned int reserve_items /* = 2000 */, unsigned int zpos_items /* = 100 */)
-    : cObject_Manager<cSprite>()
+cSprite_Manager::cSprite_Manager(unsigned int reserve_items /* = 2000 */, unsigned int zpos_items /* = 100 */, float collision_cell_size /* = cSpatial_Hash::m_default_cell_size */)
+    : cObject_Manager<cSprite>(), m_spatial_hash(collision_cell_size), m_static_tree(&m_spatial_hash)
 {
     objects.reserve(reserve_items);
 
     m_max_uid_mark = 1; // UID 0 is reserved for the player
+    m_uid_pool.assign(1, 1);
+    m_uid_pool_free_word = 0;
     m_z_pos_data.assign(zpos_items, 0.0f);
     m_z_pos_data_editor.assign(zpos_items,0.0f);
 }
@@ -75,30 +78,76 @@ void cSprite_Manager::Add(cSprite* sprite)
 //#endif
 
         // Mark the sprite’s UID as taken
-        m_uid_pool.erase(sprite->m_uid);
+        Set_UID_Used(sprite->m_uid, 1);
     }
 
-    // Check if an destroyed object can be replaced
-    for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-        // get object pointer
-        cSprite* obj = (*itr);
+    // Check if an destroyed object can be replaced, the last destroyed one is used
+    if (!m_destroyed_objects.empty()) {
+        cSprite* obj = m_destroyed_objects.back();
+        m_destroyed_objects.pop_back();
+        obj->m_manager_destroyed_num = -1;
+
+        // set new object
+        objects[obj->m_manager_array_num] = sprite;
+        sprite->m_manager_array_num = obj->m_manager_array_num;
+        m_spatial_hash.Insert(sprite);
+        m_broad_phase.Add_Pending(sprite);
+        m_col_rect_cache.Insert(sprite);
+        m_static_geometry.Add(sprite);
+        m_uid_index.insert(std::make_pair(sprite->m_uid, sprite));
+
+        // delete old
+        Delete_Destroyed(obj);
+
+        // already destroyed
+        if (sprite->m_auto_destroy) {
+            Add_Destroyed(sprite);
+        }
 
-        // if destroy is set
-        if (obj->m_auto_destroy) {
-            // set new object
-            *itr = sprite;
+        return;
+    }
+
+    cObject_Manager<cSprite>::Add(sprite);
+    sprite->m_manager_array_num = static_cast<int>(objects.size()) - 1;
+    m_uid_index.insert(std::make_pair(sprite->m_uid, sprite));
+    m_spatial_hash.Insert(sprite);
+    m_broad_phase.Add_Pending(sprite);
+    m_col_rect_cache.Insert(sprite);
+    m_static_geometry.Add(sprite);
+
+    // already destroyed
+    if (sprite->m_auto_destroy) {
+        Add_Destroyed(sprite);
+    }
+}
+
+void cSprite_Manager::Add_Destroyed(cSprite* sprite)
+{
+    // not in this manager or already added
+    if (Get_Array_Num(sprite) < 0 || sprite->m_manager_destroyed_num >= 0) {
+        return;
+    }
 
-            // Release old sprite’s UID by putting it back into the UID pool
-            m_uid_pool.insert(obj->m_uid);
+    sprite->m_manager_destroyed_num = static_cast<int>(m_destroyed_objects.size());
+    m_destroyed_objects.push_back(sprite);
+}
 
-            // delete old
-            delete obj;
+void cSprite_Manager::Remove_Destroyed(cSprite* sprite)
+{
+    const int destroyed_num = sprite->m_manager_destroyed_num;
 
-            return;
-        }
+    // not in the list
+    if (destroyed_num < 0) {
+        return;
     }
 
-    cObject_Manager<cSprite>::Add(sprite);
+    // move the last one into its place
+    cSprite* last = m_destroyed_objects.back();
+    m_destroyed_objects[destroyed_num] = last;
+    last->m_manager_destroyed_num = destroyed_num;
+    m_destroyed_objects.pop_back();
+
+    sprite->m_manager_destroyed_num = -1;
 }
 
 cSprite* cSprite_Manager::Copy(unsigned int identifier)
@@ -128,11 +177,13 @@ void cSprite_Manager::Ensure_Different_Z(cSprite* sprite)
     // the same massivity.
     if (sprite->m_pos_z <= m_z_pos_data[sprite->m_massive_type]) {
         sprite->m_pos_z = m_z_pos_data[sprite->m_massive_type] + cSprite::m_pos_z_delta;
+        sprite->Update_Static_Geometry();
     }
     // Same for editor
     if (sprite->m_editor_pos_z > 0.0f) {
         if (sprite->m_editor_pos_z <= m_z_pos_data_editor[sprite->m_massive_type]) {
             sprite->m_editor_pos_z = m_z_pos_data_editor[sprite->m_massive_type] + cSprite::m_pos_z_delta;
+            sprite->Update_Static_Geometry();
         }
     }
 
@@ -165,21 +216,27 @@ void cSprite_Manager::Move_To_Front(cSprite* sprite)
         return;
     }
 
-    // get iterator
-    cSprite_List::iterator itr = std::find(objects.begin(), objects.end(), sprite);
+    const int array_num = Get_Array_Num(sprite);
 
     // not available
-    if (itr == objects.end()) {
+    if (array_num < 0) {
         // fixme : should not happen but it does
         return;
     }
 
-    objects.erase(itr);
-    objects.front() = sprite;
-    objects.insert(objects.begin() + 1, first);
+    const size_t old_num = static_cast<size_t>(array_num);
+
+    // the objects before it move back by one
+    std::rotate(objects.begin(), objects.begin() + old_num, objects.begin() + old_num + 1);
+
+    // only the objects up to the old position moved
+    for (size_t i = 0; i <= old_num; i++) {
+        objects[i]->m_manager_array_num = static_cast<int>(i);
+    }
 
     // make it the first z position
     sprite->m_pos_z = Get_First(sprite->m_type)->m_pos_z - cSprite::m_pos_z_delta;
+    sprite->Update_Static_Geometry();
 }
 
 void cSprite_Manager::Move_To_Back(cSprite* sprite)
@@ -196,18 +253,20 @@ void cSprite_Manager::Move_To_Back(cSprite* sprite)
         return;
     }
 
-    // get iterator
-    cSprite_List::iterator itr = std::find(objects.begin(), objects.end(), sprite);
+    const int array_num = Get_Array_Num(sprite);
 
     // not available
-    if (itr == objects.end()) {
+    if (array_num < 0) {
         // fixme : should not happen but it does
         return;
     }
 
-    objects.erase(itr);
-    objects.back() = sprite;
-    objects.insert(objects.end() - 1, last);
+    const size_t old_num = static_cast<size_t>(array_num);
+
+    // the objects after it move forward by one
+    std::rotate(objects.begin() + old_num, objects.begin() + old_num + 1, objects.end());
+
+    Update_Array_Nums(old_num);
 
     // make it the last z position
     Ensure_Different_Z(sprite);
@@ -226,12 +285,22 @@ void cSprite_Manager::Delete_All(bool delayed /* = 0 */)
     }
     // instant
     else {
+        m_spatial_hash.Clear();
+        m_static_tree.Clear();
+        m_broad_phase.Clear();
+        m_col_rect_cache.Clear();
+        m_static_geometry.Clear();
+        m_destroyed_objects.clear();
+        m_uid_index.clear();
+
         // remove objects that can not be auto-deleted
         for (cSprite_List::iterator itr = objects.begin(); itr != objects.end();) {
             // get object pointer
             cSprite* obj = (*itr);
 
             if (obj->m_disallow_managed_delete) {
+                obj->m_manager_array_num = -1;
+                obj->m_manager_destroyed_num = -1;
                 itr = objects.erase(itr);
             }
             // increment
@@ -244,13 +313,129 @@ void cSprite_Manager::Delete_All(bool delayed /* = 0 */)
     }
 
     // Empty the UID pool, we have no sprites anymore
-    m_uid_pool.clear();
+    std::fill(m_uid_pool.begin(), m_uid_pool.end(), 0xFFFFFFFF);
+    m_uid_pool_free_word = m_uid_pool.size();
 
     // clear z position data
     std::fill(m_z_pos_data.begin(), m_z_pos_data.end(), 0.0f);
     std::fill(m_z_pos_data_editor.begin(), m_z_pos_data_editor.end(), 0.0f);
 }
 
+bool cSprite_Manager::Delete(size_t array_num, bool delete_data /* = 1 */)
+{
+    // out of array
+    if (array_num >= objects.size()) {
+        return 0;
+    }
+
+    return Delete(objects[array_num], delete_data);
+}
+
+bool cSprite_Manager::Delete(cSprite* sprite, bool delete_data /* = 1 */)
+{
+    // empty object
+    if (!sprite) {
+        return 0;
+    }
+
+    int array_num = Get_Array_Num(sprite);
+
+    // available in vector
+    if (array_num >= 0) {
+        // move the last object into its place
+        cSprite* last = objects.back();
+        objects[array_num] = last;
+        last->m_manager_array_num = array_num;
+        objects.pop_back();
+
+        Remove_Destroyed(sprite);
+        m_spatial_hash.Remove(sprite);
+        m_static_tree.Remove(sprite);
+        m_broad_phase.Remove(sprite);
+        m_col_rect_cache.Remove(sprite);
+        m_static_geometry.Remove(sprite);
+        Remove_UID_Index(sprite);
+        sprite->m_manager_array_num = -1;
+    }
+
+    if (delete_data) {
+        delete sprite;
+    }
+
+    return 1;
+}
+
+int cSprite_Manager::Get_Array_Num(const cSprite* sprite) const
+{
+    // invalid
+    if (!sprite) {
+        return -1;
+    }
+
+    const int array_num = sprite->m_manager_array_num;
+
+    // not in this manager
+    if (array_num < 0 || static_cast<size_t>(array_num) >= objects.size() || objects[array_num] != sprite) {
+        return -1;
+    }
+
+    return array_num;
+}
+
+void cSprite_Manager::Build_Static_Tree(void)
+{
+    cSprite_List static_objects;
+
+    for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+        cSprite* obj = (*itr);
+
+        // already static
+        if (obj->m_static_tree_entry.m_bvh == &m_static_tree) {
+            static_objects.push_back(obj);
+            continue;
+        }
+
+        // destroyed or able to move
+        if (obj->m_auto_destroy || dynamic_cast<cMovingSprite*>(obj)) {
+            continue;
+        }
+
+        m_spatial_hash.Remove(obj);
+        static_objects.push_back(obj);
+    }
+
+    m_static_tree.Build(static_objects);
+
+    debug_print("Static sprite tree : %u static, %u dynamic\n", static_cast<unsigned int>(m_static_tree.size()), static_cast<unsigned int>(m_spatial_hash.size()));
+}
+
+void cSprite_Manager::Set_Collision_Cell_Size(float cell_size)
+{
+    m_spatial_hash.Set_Cell_Size(cell_size);
+}
+
+void cSprite_Manager::Update_Array_Nums(size_t start /* = 0 */)
+{
+    for (size_t i = start; i < objects.size(); i++) {
+        objects[i]->m_manager_array_num = static_cast<int>(i);
+    }
+}
+
+void cSprite_Manager::Delete_Destroyed(cSprite* obj)
+{
+    // Release old sprite’s UID by putting it back into the UID pool
+    Set_UID_Used(obj->m_uid, 0);
+    Remove_UID_Index(obj);
+
+    m_spatial_hash.Remove(obj);
+    m_static_tree.Remove(obj);
+    m_broad_phase.Remove(obj);
+    m_col_rect_cache.Remove(obj);
+    m_static_geometry.Remove(obj);
+    obj->m_manager_array_num = -1;
+    delete obj;
+}
+
 cSprite* cSprite_Manager::Get_First(const SpriteType type) const
 {
     cSprite* first = NULL;
@@ -316,11 +501,18 @@ cSprite* cSprite_Manager::Get_from_Position(int start_pos_x, int start_pos_y, co
 
 cSprite* cSprite_Manager::Get_by_UID(int uid) const
 {
-    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-        if ((*itr)->m_uid == uid)
-            return *itr;
+    typedef std::unordered_multimap<int, cSprite*>::const_iterator Uid_Iterator;
+    const std::pair<Uid_Iterator, Uid_Iterator> range = m_uid_index.equal_range(uid);
+
+    cSprite* found = NULL;
+
+    // if the UID is used several times the first one in the array like a linear search
+    for (Uid_Iterator itr = range.first; itr != range.second; ++itr) {
+        if (!found || itr->second->m_manager_array_num < found->m_manager_array_num)
+            found = itr->second;
     }
-    return NULL;
+
+    return found;
 }
 
 void cSprite_Manager::Get_Objects_sorted(cSprite_List& new_objects, bool editor_sort /* = 0 */, bool with_player /* = 0 */) const
@@ -344,8 +536,30 @@ void cSprite_Manager::Get_Objects_sorted(cSprite_List& new_objects, bool editor_
 
 void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_rect& rect, bool with_player /* = 0 */, const cSprite* exclude_sprite /* = NULL */) const
 {
-    // Check objects
-    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+    const size_t start = col_objects.size();
+
+    m_query_candidates.clear();
+
+    // only check the broad phase pairs while handling the collisions
+    if (m_broad_phase.Is_Usable(exclude_sprite, rect)) {
+        m_broad_phase.Get_Pairs(m_query_candidates, exclude_sprite);
+    }
+    // big rect : testing all collision rects at once is faster than the cell lookups
+    else if (m_spatial_hash.Get_Query_Cell_Count(rect) > m_col_rect_cache.size() / cCol_Rect_Cache::m_cell_lookup_cost) {
+        m_query_slots.clear();
+        m_col_rect_cache.Query(m_query_slots, rect);
+
+        for (vector<unsigned int>::const_iterator itr = m_query_slots.begin(); itr != m_query_slots.end(); ++itr) {
+            m_query_candidates.push_back(m_col_rect_cache.Get_Sprite(*itr));
+        }
+    }
+    // only check objects in the touched cells and tree nodes
+    else {
+        m_spatial_hash.Query(m_query_candidates, rect);
+        m_static_tree.Query(m_query_candidates, rect);
+    }
+
+    for (cSprite_List::const_iterator itr = m_query_candidates.begin(); itr != m_query_candidates.end(); ++itr) {
         // get object pointer
         cSprite* obj = (*itr);
 
@@ -362,6 +576,9 @@ void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_
         col_objects.push_back(obj);
     }
 
+    // keep the array order
+    std::sort(col_objects.begin() + start, col_objects.end(), array_num_sort());
+
     if (with_player && pActive_Player != exclude_sprite) {
         if (rect.Intersects(pActive_Player->m_col_rect)) {
             col_objects.push_back(pActive_Player);
@@ -371,8 +588,14 @@ void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_
 
 void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_Circle& circle, bool with_player /* = 0 */, const cSprite* exclude_sprite /* = NULL */) const
 {
-    // Check objects
-    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+    const size_t start = col_objects.size();
+
+    // only check objects in the touched cells and tree nodes
+    m_query_candidates.clear();
+    m_spatial_hash.Query(m_query_candidates, circle);
+    m_static_tree.Query(m_query_candidates, circle);
+
+    for (cSprite_List::const_iterator itr = m_query_candidates.begin(); itr != m_query_candidates.end(); ++itr) {
         // get object pointer
         cSprite* obj = (*itr);
 
@@ -389,6 +612,9 @@ void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_
         col_objects.push_back(obj);
     }
 
+    // keep the array order
+    std::sort(col_objects.begin() + start, col_objects.end(), array_num_sort());
+
     if (with_player && pActive_Player != exclude_sprite) {
         if (circle.Intersects(pActive_Player->m_col_rect)) {
             col_objects.push_back(pActive_Player);
@@ -398,6 +624,12 @@ void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_
 
 void cSprite_Manager::Handle_Collision_Items(void)
 {
+    // find the touching pairs of all objects at once
+    m_broad_phase.Update(objects);
+
+    pFramerate->m_perf_timer[PERF_COLLISION_PAIRS_TESTED]->Set_Count(m_broad_phase.m_pairs_tested);
+    pFramerate->m_perf_timer[PERF_COLLISION_PAIRS_FOUND]->Set_Count(m_broad_phase.m_pairs_found);
+
     for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
         cSprite* obj = (*itr);
 
@@ -411,11 +643,53 @@ void cSprite_Manager::Handle_Collision_Items(void)
             continue;
         }
 
+        // outside the activation region : only handle collisions reported by awake objects
+        if (obj->m_sleeping) {
+            if (obj->m_collisions.size()) {
+                obj->Handle_Collisions();
+            }
+
+            continue;
+        }
+
         // collision and movement handling
         obj->Collide_Move();
         // handle found collisions
         obj->Handle_Collisions();
     }
+
+    // the positions change until the next update
+    m_broad_phase.Invalidate();
+}
+
+void cSprite_Manager::Update_Sleeping(const GL_rect& region, float margin)
+{
+    // disabled
+    if (margin <= 0.0f) {
+        for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+            (*itr)->m_sleeping = 0;
+        }
+
+        return;
+    }
+
+    for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+        cSprite* obj = (*itr);
+
+        // controlled from elsewhere
+        if (obj->m_always_active || obj->has_event_handlers()) {
+            obj->m_sleeping = 0;
+            continue;
+        }
+
+        // never sleep where the object would still act by itself, the camera range is the per-type distance
+        const float obj_margin = std::max(margin, static_cast<float>(obj->m_camera_range));
+
+        obj->m_sleeping = obj->m_rect.m_x + obj->m_rect.m_w < region.m_x - obj_margin ||
+                          obj->m_rect.m_x > region.m_x + region.m_w + obj_margin ||
+                          obj->m_rect.m_y + obj->m_rect.m_h < region.m_y - obj_margin ||
+                          obj->m_rect.m_y > region.m_y + region.m_h + obj_margin;
+    }
 }
 
 unsigned int cSprite_Manager::Get_Size_Array(const ArrayType sprite_array)
@@ -431,13 +705,13 @@ unsigned int cSprite_Manager::Get_Size_Array(const ArrayType sprite_array)
     return count;
 }
 
-/* The member m_uid_pool contains a list of all those UIDs that
- * are *not* currently in use, sorted from the smallest to
- * the greatest (not necessarily without gaps, as destroyed
- * sprites give their UID back into the pool). This allows
- * use to quickly find the next free UID without much searching
- * by just picking the very first element from m_uid_pool,
- * which, as said, is always sorted and stays so.
+/* The member m_uid_pool is a bitmap of all UIDs below
+ * m_max_uid_mark with a set bit for the UIDs which are currently
+ * in use (not necessarily without gaps, as destroyed sprites give
+ * their UID back into the pool). The next free UID is the first
+ * cleared bit, and m_uid_pool_free_word remembers the first word
+ * which may contain one, so that generating UIDs does not need to
+ * search the whole bitmap again.
  *
  * However, at the level start this would mean that m_uid_pool
  * must contain infinitely many numbers reaching from 1 to ∞. Well,
@@ -445,19 +719,39 @@ unsigned int cSprite_Manager::Get_Size_Array(const ArrayType sprite_array)
  * bare `int' type and is hence limited to INT_MAX. As we don’t want
  * to allocate space for all those possible UIDs which we will likely
  * never need right from the start on, we instead just allocate the
- * next ten UIDs for the pool if it is empty, remembering the new
+ * next ten UIDs for the pool if it is full, remembering the new
  * highest possible UID in m_max_uid_mark. */
 int cSprite_Manager::Generate_UID()
 {
-    // Allocate 10 new UIDs if the pool is empty
-    if (m_uid_pool.empty())
-        Allocate_UIDs(m_max_uid_mark + 10);
+    while (1) {
+        // Search the first word with a free UID
+        for (; m_uid_pool_free_word < m_uid_pool.size(); m_uid_pool_free_word++) {
+            const uint32_t word = m_uid_pool[m_uid_pool_free_word];
+
+            if (word != 0xFFFFFFFF) {
+                break;
+            }
+        }
+
+        if (m_uid_pool_free_word < m_uid_pool.size()) {
+            const uint32_t word = m_uid_pool[m_uid_pool_free_word];
+            int bit = 0;
+
+            while (word & (1u << bit))
+                bit++;
+
+            const int id = static_cast<int>(m_uid_pool_free_word * 32) + bit;
+
+            // Pool is not full, return the first available UID.
+            if (id < m_max_uid_mark) {
+                Set_UID_Used(id, 1);
+                return id;
+            }
+        }
 
-    // Pool is not empty, return the first available UID.
-    std::set<int>::const_iterator iter = m_uid_pool.begin();
-    int id = *iter;
-    m_uid_pool.erase(iter);
-    return id;
+        // Allocate 10 new UIDs if the pool is full
+        Allocate_UIDs(m_max_uid_mark + 10);
+    }
 }
 
 // We need `long', because we must check an `int' overflow (see below)
@@ -473,13 +767,16 @@ void cSprite_Manager::Allocate_UIDs(long new_max_uid_mark)
     if (new_max_uid_mark >= INT_MAX)
         throw(std::range_error("Too many sprites, unable to generate further UIDs!"));
 
-    // Actually allocate the numbers for the UID pool
-    for (int i = m_max_uid_mark; i < static_cast<int>(new_max_uid_mark); i++) // new_max_uid_mark is guaranteed to be < INT_MAX
-        m_uid_pool.insert(i);
+    const int old_max_uid_mark = m_max_uid_mark;
 
     // Remember the new maximum. Note that by checking INT_MAX, we have
     // ensured the values fits into an int.
     m_max_uid_mark = static_cast<int>(new_max_uid_mark);
+    m_uid_pool.resize((static_cast<size_t>(m_max_uid_mark) + 31) / 32, 0);
+
+    // Actually allocate the numbers for the UID pool
+    for (int i = old_max_uid_mark; i < m_max_uid_mark; i++)
+        Set_UID_Used(i, 0);
 }
 
 bool cSprite_Manager::Is_UID_In_Use(int uid)
@@ -493,10 +790,42 @@ bool cSprite_Manager::Is_UID_In_Use(int uid)
     if (uid >= m_max_uid_mark)
         return false;
 
-    if (m_uid_pool.find(uid) == m_uid_pool.end())
+    if (uid < 0)
         return true;
 
-    return false;
+    return (m_uid_pool[uid / 32] & (1u << (uid % 32))) != 0;
+}
+
+void cSprite_Manager::Set_UID_Used(int uid, bool used)
+{
+    // not in the pool
+    if (uid < 0 || uid >= m_max_uid_mark)
+        return;
+
+    const size_t word = static_cast<size_t>(uid) / 32;
+
+    if (used) {
+        m_uid_pool[word] |= 1u << (uid % 32);
+    }
+    else {
+        m_uid_pool[word] &= ~(1u << (uid % 32));
+
+        if (word < m_uid_pool_free_word)
+            m_uid_pool_free_word = word;
+    }
+}
+
+void cSprite_Manager::Remove_UID_Index(const cSprite* sprite)
+{
+    typedef std::unordered_multimap<int, cSprite*>::iterator Uid_Iterator;
+    const std::pair<Uid_Iterator, Uid_Iterator> range = m_uid_index.equal_range(sprite->m_uid);
+
+    for (Uid_Iterator itr = range.first; itr != range.second; ++itr) {
+        if (itr->second == sprite) {
+            m_uid_index.erase(itr);
+            return;
+        }
+    }
 }
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
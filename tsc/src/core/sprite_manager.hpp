@@ -19,6 +19,11 @@
 
 #include "../core/global_game.hpp"
 #include "../core/obj_manager.hpp"
+#include "../core/spatial_hash.hpp"
+#include "../core/sprite_bvh.hpp"
+#include "../core/sort_and_sweep.hpp"
+#include "../core/col_rect_cache.hpp"
+#include "../video/static_geometry.hpp"
 #include "../objects/movingsprite.hpp"
 
 namespace TSC {
@@ -27,7 +32,11 @@ namespace TSC {
 
     class cSprite_Manager : public cObject_Manager<cSprite> {
     public:
-        cSprite_Manager(unsigned int reserve_items = 2000, unsigned int zpos_items = 100);
+        /* reserve_items : initial objects array capacity
+         * zpos_items : z position data entries
+         * collision_cell_size : spatial hash cell size used for collision queries
+        */
+        cSprite_Manager(unsigned int reserve_items = 2000, unsigned int zpos_items = 100, float collision_cell_size = cSpatial_Hash::m_default_cell_size);
         virtual ~cSprite_Manager(void);
 
         /* Add a sprite
@@ -50,10 +59,38 @@ namespace TSC {
         */
         void Move_To_Back(cSprite* sprite);
 
+        /* Delete the object from given array number
+         * the last object is moved into its place
+        */
+        virtual bool Delete(size_t array_num, bool delete_data = 1);
+        // Delete the given object, see above
+        virtual bool Delete(cSprite* sprite, bool delete_data = 1);
         /* Delete all objects
          * if delayed is set deletion will only occur if replaced
          */
         virtual void Delete_All(bool delayed = 0);
+        // Remember the destroyed sprite so that Add() can replace it
+        void Add_Destroyed(cSprite* sprite);
+
+        /* Return the object array number
+         * if not found returns -1
+        */
+        int Get_Array_Num(const cSprite* sprite) const;
+
+        /* Move all sprites which can not move by themselves into the static sprite tree
+         * should be called once after loading, sprites moved later become dynamic again
+        */
+        void Build_Static_Tree(void);
+
+        /* Set the spatial hash cell size used for collision queries
+         * should be about two times the common tile size
+        */
+        void Set_Collision_Cell_Size(float cell_size);
+        // Return the spatial hash cell size
+        inline float Get_Collision_Cell_Size(void) const
+        {
+            return m_spatial_hash.Get_Cell_Size();
+        }
 
         // Return the first z position object from the given type
         cSprite* Get_First(const SpriteType type) const;
@@ -75,6 +112,7 @@ namespace TSC {
         */
         void Get_Objects_sorted(cSprite_List& new_objects, bool editor_sort = 0, bool with_player = 0) const;
         /* Get objects colliding with the given rectangle/circle
+         * the objects are added in array order
          * with_player : include player in check
          * exclude_sprite : exclude the given sprite from check
         */
@@ -88,10 +126,19 @@ namespace TSC {
                 (*itr)->Update_Valid_Draw();
             }
         }
+        /* Put the items outside the activation region to sleep and wake up the others
+         * the region is the given rect extended by the given margin or the bigger margin of the item type
+         * if margin is 0 or less all items are awake
+        */
+        void Update_Sleeping(const GL_rect& region, float margin);
         // Update items
         inline void Update_Items(void)
         {
             for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+                if ((*itr)->m_sleeping) {
+                    continue;
+                }
+
                 (*itr)->Update();
             }
         }
@@ -99,18 +146,31 @@ namespace TSC {
         inline void Update_Items_Late(void)
         {
             for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+                if ((*itr)->m_sleeping) {
+                    continue;
+                }
+
                 (*itr)->Update_Late();
             }
         }
         // Draw items
         inline void Draw_Items(void)
         {
+            // the baked sprites are drawn from the cache
+            const bool static_cached = m_static_geometry.Draw();
+
             for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+                if (static_cached && (*itr)->m_static_geometry_entry.m_baked) {
+                    continue;
+                }
+
                 (*itr)->Draw();
             }
         }
 
-        // Create Collision data and Handle the collisions
+        /* Create Collision data and Handle the collisions
+         * the broad phase pairs are updated once before and used by all collision checks
+        */
         void Handle_Collision_Items(void);
 
 
@@ -141,12 +201,25 @@ namespace TSC {
         ZposList m_z_pos_data;
         // biggest editor type z position
         ZposList m_z_pos_data_editor;
-        // This set holds the not-yet-used UIDs so we can easily
-        // find the next free one.
-        std::set<int> m_uid_pool;
+        // One bit for each UID below m_max_uid_mark, set if the UID
+        // is taken.
+        vector<uint32_t> m_uid_pool;
+        // The first word of m_uid_pool which may contain a free UID.
+        size_t m_uid_pool_free_word;
         // The UID pool is filled as needed. This is always the first
         // non-yet allocated UID.
         int m_max_uid_mark;
+        // The objects by UID. Several objects can have the same UID
+        // if a generated one collides with one set in the level XML.
+        std::unordered_multimap<int, cSprite*> m_uid_index;
+
+        // Array number sort
+        struct array_num_sort {
+            bool operator()(const cSprite* a, const cSprite* b) const
+            {
+                return a->m_manager_array_num < b->m_manager_array_num;
+            }
+        };
 
         // Z position sort
         struct zpos_sort {
@@ -193,6 +266,34 @@ namespace TSC {
          * are ensured to be placed in front of older ones.
          */
         void Ensure_Different_Z(cSprite* sprite);
+        // Set the array number of all objects from the given position on
+        void Update_Array_Nums(size_t start = 0);
+        // Mark the UID below m_max_uid_mark as taken or free
+        void Set_UID_Used(int uid, bool used);
+        // Remove the sprite from the UID index, other sprites with the same UID stay
+        void Remove_UID_Index(const cSprite* sprite);
+        // Forget the destroyed sprite if it was remembered
+        void Remove_Destroyed(cSprite* sprite);
+        // Delete the destroyed object which was replaced in the array
+        void Delete_Destroyed(cSprite* obj);
+
+        // collision rects of the dynamic objects
+        cSpatial_Hash m_spatial_hash;
+        // collision rects of the static objects
+        cSprite_BVH m_static_tree;
+        // touching pairs while handling the collisions
+        cSort_And_Sweep m_broad_phase;
+        // collision rects of all objects for batch tests
+        cCol_Rect_Cache m_col_rect_cache;
+        // vertex buffers of the static objects images
+        cStatic_Geometry m_static_geometry;
+        // temporary spatial hash query result
+        mutable cSprite_List m_query_candidates;
+        // temporary collision rect cache query result
+        mutable vector<unsigned int> m_query_slots;
+
+        // destroyed objects which Add() can replace
+        cSprite_List m_destroyed_objects;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -171,6 +171,9 @@ void cStaticEnemy::Set_Path_Identifier(const std::string& path)
 {
     m_path_state.Set_Path_Identifier(path);
     Set_Velocity(0.0f, 0.0f);
+
+    // keep the path position in sync with the other path users
+    m_always_active = !path.empty();
 }
 
 void cStaticEnemy::Set_Speed(float speed)
@@ -14,6 +14,8 @@
 #include "../scripting/events/gold_100_event.hpp"
 #include "../core/property_helper.hpp"
 #include "../core/framerate.hpp"
+#include "../video/particle_budget.hpp"
+#include "../user/preferences.hpp"
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/sprite_manager.hpp"
 #include "hud.hpp"
@@ -52,7 +54,7 @@ cHud::cHud()
       mp_display_item(NULL), m_rescue_item_type(TYPE_UNDEFINED),
       m_elapsed_time(0), m_last_time(std::chrono::system_clock::now()),
       m_text_counter(0.0f), mp_hud_root(NULL), mp_points_label(NULL), mp_time_label(NULL),
-      mp_jewels_label(NULL), mp_lives_label(NULL), mp_fps_label(NULL),
+      mp_jewels_label(NULL), mp_lives_label(NULL), mp_fps_label(NULL), mp_particles_label(NULL),
       mp_waypoint_label(NULL), mp_world_label(NULL), mp_message_text(NULL), mp_item_image(NULL)
 {
     load_hud_images_into_cegui();
@@ -66,6 +68,7 @@ cHud::cHud()
     mp_jewels_label   = mp_hud_root->getChild("jewels");
     mp_lives_label    = mp_hud_root->getChild("lives");
     mp_fps_label      = mp_hud_root->getChild("debug_fps");
+    mp_particles_label = mp_hud_root->getChild("debug_particles");
     mp_waypoint_label = mp_hud_root->getChild("world_waypoint");
     mp_world_label    = mp_hud_root->getChild("world_name");
     mp_message_text   = mp_hud_root->getChild("message");
@@ -79,6 +82,7 @@ cHud::cHud()
 
     // Hide by default
     mp_fps_label->hide();
+    mp_particles_label->hide();
     mp_message_text->hide();
     mp_item_image->hide();
 
@@ -131,6 +135,7 @@ void cHud::Show()
 void cHud::Show_Debug_Widgets()
 {
     mp_fps_label->show();
+    mp_particles_label->show();
 }
 
 void cHud::Hide()
@@ -141,12 +146,14 @@ void cHud::Hide()
 void cHud::Hide_Debug_Widgets()
 {
     mp_fps_label->hide();
+    mp_particles_label->hide();
 }
 
 void cHud::Update()
 {
     static char timestr[32];
     static char fps[128];
+    static char particles[256];
     static int seconds;
 
     // Do nothing if not shown anyway
@@ -197,6 +204,20 @@ void cHud::Update()
                 pFramerate->m_fps_worst,
                 pFramerate->m_fps);
         mp_fps_label->setText(fps);
+
+        // live particles and throttling
+        sprintf(particles,
+                // TRANS: Do not translate the part in brackets
+                _("[colour='FFFFFF00']Particles: %u / %u Emitters: %u Ambience: %u (%d%%) Gameplay: %u (%d%%) %s"),
+                pParticle_Budget->Get_Live_Particles(),
+                pPreferences->m_video_particle_max,
+                pParticle_Budget->Get_Emitter_Count(),
+                pParticle_Budget->Get_Live_Particles(PARTICLE_PRIORITY_AMBIENCE),
+                static_cast<int>(pParticle_Budget->Get_Emit_Factor(PARTICLE_PRIORITY_AMBIENCE) * 100.0f),
+                pParticle_Budget->Get_Live_Particles(PARTICLE_PRIORITY_GAMEPLAY),
+                static_cast<int>(pParticle_Budget->Get_Emit_Factor(PARTICLE_PRIORITY_GAMEPLAY) * 100.0f),
+                pParticle_Budget->Is_Throttled() ? _("Throttled") : "");
+        mp_particles_label->setText(particles);
     }
 }
 
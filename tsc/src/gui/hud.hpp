@@ -105,6 +105,7 @@ namespace TSC {
         CEGUI::Window* mp_jewels_label;
         CEGUI::Window* mp_lives_label;
         CEGUI::Window* mp_fps_label;
+        CEGUI::Window* mp_particles_label;
         CEGUI::Window* mp_waypoint_label;
         CEGUI::Window* mp_world_label;
         CEGUI::Window* mp_message_text;
@@ -386,7 +386,7 @@ void cMenuCore::Load(const MenuID menu /* = MENU_MAIN */, const GameMode exit_ga
     pMouseCursor->Double_Click(0);
 
     // default background color to white
-    glClearColor(1, 1, 1, 1);
+    pVideo->m_clear_color = white;
 
     // Set ID
     m_menu_id = menu;
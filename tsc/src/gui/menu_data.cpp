@@ -3551,7 +3551,7 @@ void cMenu_Credits::Init_GUI(void)
 void cMenu_Credits::Enter(const GameMode old_mode /* = MODE_NOTHING */)
 {
     // black background because of fade alpha
-    glClearColor(0, 0, 0, 1);
+    pVideo->m_clear_color = black;
 
     if (old_mode == MODE_MENU) {
         // fade in
@@ -3566,7 +3566,7 @@ void cMenu_Credits::Leave(const GameMode next_mode /* = MODE_NOTHING */)
         Menu_Fade(0);
 
         // white background
-        glClearColor(1, 1, 1, 1);
+        pVideo->m_clear_color = white;
     }
 
     // set menu gradient colors back
@@ -3686,7 +3686,7 @@ void cMenu_Credits::Update(void)
         Exit();
     }
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Escape) || sf::Keyboard::isKeyPressed(sf::Keyboard::Return) ||
+    if (pKeyboard->Is_Key_Pressed(sf::Keyboard::Escape) || pKeyboard->Is_Key_Pressed(sf::Keyboard::Return) ||
             pJoystick->Button(pPreferences->m_joy_button_action) || pJoystick->Button(pPreferences->m_joy_button_exit)) {
         Exit();
     }
@@ -46,6 +46,15 @@ cKeyboard::~cKeyboard(void)
 
 }
 
+bool cKeyboard::Is_Key_Pressed(sf::Keyboard::Key key) const
+{
+    if (game_headless) {
+        return 0;
+    }
+
+    return sf::Keyboard::isKeyPressed(key);
+}
+
 bool cKeyboard::CEGUI_Handle_Key_Up(sf::Keyboard::Key key) const
 {
     // inject the scancode directly
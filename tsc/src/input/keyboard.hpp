@@ -39,9 +39,13 @@ namespace TSC {
             return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "InputClass"), &Scripting::rtTSC_Scriptable, this));
         }
 
+        /* Check if the key is held down
+         * always false in headless mode as there is no display to ask
+        */
+        bool Is_Key_Pressed(sf::Keyboard::Key key) const;
         // Check the state of the Shift and Ctrl keys.
-        inline bool Is_Shift_Down(){ return sf::Keyboard::isKeyPressed(sf::Keyboard::LShift) || sf::Keyboard::isKeyPressed(sf::Keyboard::RShift); }
-        inline bool Is_Ctrl_Down(){ return sf::Keyboard::isKeyPressed(sf::Keyboard::LControl) || sf::Keyboard::isKeyPressed(sf::Keyboard::RControl); }
+        inline bool Is_Shift_Down(){ return Is_Key_Pressed(sf::Keyboard::LShift) || Is_Key_Pressed(sf::Keyboard::RShift); }
+        inline bool Is_Ctrl_Down(){ return Is_Key_Pressed(sf::Keyboard::LControl) || Is_Key_Pressed(sf::Keyboard::RControl); }
 
         /* CEGUI Key Up handler
          * returns true if CEGUI processed the given key up event
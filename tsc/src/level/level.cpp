@@ -95,6 +95,8 @@ namespace TSC {
 
 /* *** *** *** *** *** cLevel *** *** *** *** *** *** *** *** *** *** *** *** */
 
+const float cLevel::m_default_activation_margin = 1000.0f;
+
 cLevel::cLevel(void)
 {
     // settings
@@ -310,6 +312,7 @@ fs::path cLevel::Save_To_File(fs::path filename /* = fs::path() */)
     Add_Property(p_node, "cam_limit_w", static_cast<int>(m_camera_limits.m_w));
     Add_Property(p_node, "cam_limit_h", static_cast<int>(m_camera_limits.m_h));
     Add_Property(p_node, "cam_fixed_hor_vel", m_fixed_camera_hor_vel);
+    Add_Property(p_node, "activation_margin", static_cast<int>(m_activation_margin));
     Add_Property(p_node, "unload_after_exit", m_unload_after_exit ? 1 : 0);
     // </settings>
 
@@ -422,6 +425,7 @@ void cLevel::Reset_Settings(void)
     // camera
     m_camera_limits = cCamera::m_default_limits;
     m_fixed_camera_hor_vel = 0.0f;
+    m_activation_margin = m_default_activation_margin;
 
     // unload after exit
     m_unload_after_exit = false;
@@ -444,13 +448,19 @@ void cLevel::Init(void)
     // player reset
     pLevel_Player->Reset();
 
+    // the level emitters start the same on every computer
+    const uint32_t random_seed = Get_Random_Seed(path_to_utf8(m_level_filename.filename()));
+    unsigned int emitter_num = 0;
+
     // pre-update animations
     for (cSprite_List::iterator itr = m_sprite_manager->objects.begin(); itr != m_sprite_manager->objects.end(); ++itr) {
         cSprite* obj = (*itr);
 
         if (obj->m_type == TYPE_PARTICLE_EMITTER) {
             cParticle_Emitter* emitter = static_cast<cParticle_Emitter*>(obj);
+            emitter->Set_Random_Seed(random_seed, emitter_num);
             emitter->Pre_Update();
+            emitter_num++;
         }
     }
 
@@ -602,7 +612,8 @@ void cLevel::Update(void)
             (*itr)->Update();
         }
 
-        // objects
+        // objects near the camera
+        m_sprite_manager->Update_Sleeping(pActive_Camera->Get_Rect(), m_activation_margin);
         m_sprite_manager->Update_Items();
         // animations
         m_animation_manager->Update();
@@ -792,7 +803,7 @@ bool cLevel::Key_Down(const sf::Event& evt)
         pLevel_Player->Action_Interact(INP_ITEM);
     }
     // God Mode
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::G) && sf::Keyboard::isKeyPressed(sf::Keyboard::O) && sf::Keyboard::isKeyPressed(sf::Keyboard::D) && !editor_enabled) {
+    else if (pKeyboard->Is_Key_Pressed(sf::Keyboard::G) && pKeyboard->Is_Key_Pressed(sf::Keyboard::O) && pKeyboard->Is_Key_Pressed(sf::Keyboard::D) && !editor_enabled) {
         if (pLevel_Player->m_god_mode) {
             gp_hud->Set_Text(_("Omega Mode disabled"));
         }
@@ -803,7 +814,7 @@ bool cLevel::Key_Down(const sf::Event& evt)
         pLevel_Player->m_god_mode = !pLevel_Player->m_god_mode;
     }
     // Set Small state
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::K) && sf::Keyboard::isKeyPressed(sf::Keyboard::I) && sf::Keyboard::isKeyPressed(sf::Keyboard::D) && !editor_enabled) {
+    else if (pKeyboard->Is_Key_Pressed(sf::Keyboard::K) && pKeyboard->Is_Key_Pressed(sf::Keyboard::I) && pKeyboard->Is_Key_Pressed(sf::Keyboard::D) && !editor_enabled) {
         pLevel_Player->Set_Type(ALEX_SMALL, 0);
     }
     // Exit
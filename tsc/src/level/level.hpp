@@ -213,6 +213,12 @@ namespace TSC {
         // camera
         GL_rect m_camera_limits;
         float m_fixed_camera_hor_vel;
+        /* distance around the camera in which objects are updated
+         * objects outside are put to sleep, 0 disables it
+        */
+        float m_activation_margin;
+        // default activation margin
+        static const float m_default_activation_margin;
         // Unload after exiting (for a sublevel used from the same level more than once)
         bool m_unload_after_exit;
     };
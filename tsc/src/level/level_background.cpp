@@ -18,6 +18,7 @@
 #include "../user/preferences.hpp"
 #include "../core/game_core.hpp"
 #include "../video/gl_surface.hpp"
+#include "../video/renderer.hpp"
 #include "../core/framerate.hpp"
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/filesystem/package_manager.hpp"
@@ -32,6 +33,17 @@ namespace fs = boost::filesystem;
 
 namespace TSC {
 
+/* Returns true if the image can be tiled with a repeated texture
+ * it needs a texture of its own and must be drawn unmodified
+ * the image is padded to the power of 2 texture size so repeating the texture
+ * draws the same tiles as blitting it
+*/
+static bool Is_Image_Repeatable(const cGL_Surface* image)
+{
+    return !image->m_atlas && image->m_image && image->m_w == image->m_start_w && image->m_h == image->m_start_h &&
+           image->m_base_rot_x == 0.0f && image->m_base_rot_y == 0.0f && image->m_base_rot_z == 0.0f;
+}
+
 /* *** *** *** *** *** *** *** cBackground *** *** *** *** *** *** *** *** *** *** */
 
 cBackground::cBackground(cSprite_Manager* sprite_manager)
@@ -208,6 +220,18 @@ void cBackground::Set_Image(const fs::path& img_file_1)
     Set_Image_Set("main", true);
 }
 
+void cBackground::Set_Image_Set_Image(cGL_Surface* new_image, bool new_imagestart /* = 0 */)
+{
+    m_image_1 = new_image;
+
+    /* small images are put into the atlas when loaded
+     * every image background is tiled and drawn with a repeated texture
+    */
+    if (m_image_1) {
+        m_image_1->Leave_Atlas();
+    }
+}
+
 void cBackground::Set_Scroll_Speed(const float x /* = 1.0f */, const float y /* = 1.0f */)
 {
     m_speed_x = x;
@@ -297,7 +321,13 @@ void cBackground::Draw(void)
             }
         }
 
+        if (Is_Image_Repeatable(m_image_1)) {
+            Draw_Image_Repeated(posx_final, posy_final);
+            return;
+        }
+
         // draw until width is filled
+        // rotated or resized images need a request for each tile
         while (posx_final < game_res_w) {
             // draw horizontal
             m_image_1->Blit(posx_final, posy_final, m_pos_z);
@@ -320,6 +350,33 @@ void cBackground::Draw(void)
     }
 }
 
+void cBackground::Draw_Image_Repeated(float x, float y)
+{
+    cSurface_Request* request = new cSurface_Request();
+    m_image_1->Blit_Data(request);
+
+    // fill the width
+    request->m_w = game_res_w - x;
+    // tile count is the texture coordinate
+    request->m_tex_right = request->m_w / m_image_1->m_w;
+    request->m_repeat_x = 1;
+
+    // fill the height
+    if (m_type == BG_IMG_ALL) {
+        request->m_h = game_res_h - y;
+        request->m_tex_bottom = request->m_h / m_image_1->m_h;
+        request->m_repeat_y = 1;
+    }
+
+    // position
+    request->m_pos_x += x;
+    request->m_pos_y += y;
+    request->m_pos_z = m_pos_z;
+
+    // add request
+    pRenderer->Add(request);
+}
+
 void cBackground::Draw_Gradient(void)
 {
     // no need to draw a gradient if both colors are the same
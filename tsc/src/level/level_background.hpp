@@ -71,9 +71,8 @@ namespace TSC {
         void Set_Pos_Z(const float val);
         // Set the Background image
         void Set_Image(const boost::filesystem::path& img_file_1);
-        virtual void Set_Image_Set_Image(cGL_Surface* new_image, bool new_imagestart = 0) {
-            m_image_1 = new_image;
-        }
+        // Set the current image, it is moved out of the atlas to repeat its texture
+        virtual void Set_Image_Set_Image(cGL_Surface* new_image, bool new_imagestart = 0);
         // Set the Background Image scrolling speed
         void Set_Scroll_Speed(const float x = 1.0f, const float y = 1.0f);
 
@@ -88,6 +87,10 @@ namespace TSC {
         void Draw(void);
         // draw gradient
         void Draw_Gradient(void);
+        /* draw the image tiled from the given start position
+         * as one quad with a repeated texture
+        */
+        void Draw_Image_Repeated(float x, float y);
 
         // Returns the name of the current type
         std::string Get_Type_Name(void) const;
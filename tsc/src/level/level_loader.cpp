@@ -105,6 +105,9 @@ void cLevelLoader::on_end_document()
     // engine version entry not set
     if (mp_level->m_engine_version < 0)
         mp_level->m_engine_version = 0;
+
+    // sprites which can not move are only placed once for collision checks
+    mp_level->m_sprite_manager->Build_Static_Tree();
 }
 
 void cLevelLoader::on_start_element(const Glib::ustring& name, const xmlpp::SaxParser::AttributeList& properties)
@@ -211,6 +214,9 @@ void cLevelLoader::Parse_Tag_Settings()
 
     mp_level->m_fixed_camera_hor_vel = string_to_float(m_current_properties["cam_fixed_hor_vel"]);
 
+    if (m_current_properties.count("activation_margin"))
+        mp_level->m_activation_margin = string_to_float(m_current_properties["activation_margin"]);
+
     mp_level->m_camera_limits = GL_rect(string_to_float(m_current_properties["cam_limit_x"]),
                                         string_to_float(m_current_properties["cam_limit_y"]),
                                         string_to_float(m_current_properties["cam_limit_w"]),
@@ -282,6 +288,12 @@ void cLevelLoader::Parse_Level_Object_Tag(const std::string& name)
         if (m_current_properties.count("uid"))
             sprites[0]->m_uid = string_to_int(m_current_properties["uid"]); // The 98% case is that we get only one sprite back, the other 2% are backward compatibility
 
+        // objects driven by scripts through timers or UIDS[] must not sleep
+        if (m_current_properties.count("always_active") && string_to_bool(m_current_properties["always_active"])) {
+            sprites[0]->m_always_active = true;
+            sprites[0]->m_always_active_set = true;
+        }
+
         for (std::vector<cSprite*>::iterator iter = sprites.begin(); iter != sprites.end(); iter++)
             mp_level->m_sprite_manager->Add(*iter);
     }
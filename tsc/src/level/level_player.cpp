@@ -186,7 +186,7 @@ bool cLevel_Player::Set_On_Ground(cSprite* obj, bool set_on_top /* = 1 */)
         }
 
         // if massive ground and ducking key is pressed
-        if (m_ground_object->m_massive_type == MASS_MASSIVE && (sf::Keyboard::isKeyPressed(pPreferences->m_key_down) || pJoystick->Down())) {
+        if (m_ground_object->m_massive_type == MASS_MASSIVE && (pKeyboard->Is_Key_Pressed(pPreferences->m_key_down) || pJoystick->Down())) {
             Start_Ducking();
         }
     }
@@ -399,7 +399,7 @@ animation_end:
             // TODO: Why is the below not simply handled as events in the above event loop?
 
             // Escape stops
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Escape) || sf::Keyboard::isKeyPressed(sf::Keyboard::Return) ||sf::Keyboard::isKeyPressed(sf::Keyboard::Space) || sf::Keyboard::isKeyPressed(pPreferences->m_key_action)) {
+            if (pKeyboard->Is_Key_Pressed(sf::Keyboard::Escape) || pKeyboard->Is_Key_Pressed(sf::Keyboard::Return) ||pKeyboard->Is_Key_Pressed(sf::Keyboard::Space) || pKeyboard->Is_Key_Pressed(pPreferences->m_key_action)) {
                 break;
             }
 
@@ -636,7 +636,7 @@ void cLevel_Player::Update_Walking(void)
     }
 
     // only if left or right is pressed, and game console is not open
-    if ((sf::Keyboard::isKeyPressed(pPreferences->m_key_left) || sf::Keyboard::isKeyPressed(pPreferences->m_key_right) || pJoystick->Left() || pJoystick->Right()) && !gp_game_console->IsVisible()) {
+    if ((pKeyboard->Is_Key_Pressed(pPreferences->m_key_left) || pKeyboard->Is_Key_Pressed(pPreferences->m_key_right) || pJoystick->Left() || pJoystick->Right()) && !gp_game_console->IsVisible()) {
         float ground_mod = 1.0f;
 
         if (m_ground_object && m_ground_object->m_image) {
@@ -740,7 +740,7 @@ void cLevel_Player::Update_Staying(void)
     }
 
     // if left and right is not pressed
-    if (!sf::Keyboard::isKeyPressed(pPreferences->m_key_left) && !sf::Keyboard::isKeyPressed(pPreferences->m_key_right) && !pJoystick->Left() && !pJoystick->Right()) {
+    if (!pKeyboard->Is_Key_Pressed(pPreferences->m_key_left) && !pKeyboard->Is_Key_Pressed(pPreferences->m_key_right) && !pJoystick->Left() && !pJoystick->Right()) {
         // walking
         if (m_velx) {
             if (m_ground_object->m_image && m_ground_object->m_image->m_ground_type == GROUND_ICE) {
@@ -806,7 +806,7 @@ void cLevel_Player::Update_Flying(void)
         }
 
         // move down
-        if (sf::Keyboard::isKeyPressed(pPreferences->m_key_down) || pJoystick->Down()) {
+        if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_down) || pJoystick->Down()) {
             const float max_vel = 5.0f * Get_Vel_Modifier();
 
             if (m_vely < max_vel) {
@@ -814,7 +814,7 @@ void cLevel_Player::Update_Flying(void)
             }
         }
         // move up
-        else if (sf::Keyboard::isKeyPressed(pPreferences->m_key_up) || pJoystick->Up()) {
+        else if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_up) || pJoystick->Up()) {
             const float max_vel = -5.0f * Get_Vel_Modifier();
 
             if (m_vely > max_vel) {
@@ -833,7 +833,7 @@ void cLevel_Player::Update_Flying(void)
     // falling
     else {
         // move left
-        if ((sf::Keyboard::isKeyPressed(pPreferences->m_key_left) || pJoystick->Left()) && !m_ducked_counter) {
+        if ((pKeyboard->Is_Key_Pressed(pPreferences->m_key_left) || pJoystick->Left()) && !m_ducked_counter) {
             if (!m_parachute) {
                 const float max_vel = -10.0f * Get_Vel_Modifier();
 
@@ -851,7 +851,7 @@ void cLevel_Player::Update_Flying(void)
             }
         }
         // move right
-        else if ((sf::Keyboard::isKeyPressed(pPreferences->m_key_right) || pJoystick->Right()) && !m_ducked_counter) {
+        else if ((pKeyboard->Is_Key_Pressed(pPreferences->m_key_right) || pJoystick->Right()) && !m_ducked_counter) {
             if (!m_parachute) {
                 const float max_vel = 10.0f * Get_Vel_Modifier();
 
@@ -1091,17 +1091,17 @@ void cLevel_Player::Update_Climbing(void)
 
     if (Is_On_Climbable()) {
         // set velocity
-        if (sf::Keyboard::isKeyPressed(pPreferences->m_key_left) || pJoystick->Left()) {
+        if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_left) || pJoystick->Left()) {
             m_velx = -2.0f * Get_Vel_Modifier();
         }
-        else if (sf::Keyboard::isKeyPressed(pPreferences->m_key_right) || pJoystick->Right()) {
+        else if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_right) || pJoystick->Right()) {
             m_velx = 2.0f * Get_Vel_Modifier();
         }
 
-        if (sf::Keyboard::isKeyPressed(pPreferences->m_key_up) || pJoystick->Up()) {
+        if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_up) || pJoystick->Up()) {
             m_vely = -4.0f * Get_Vel_Modifier();
         }
-        else if (sf::Keyboard::isKeyPressed(pPreferences->m_key_down) || pJoystick->Down()) {
+        else if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_down) || pJoystick->Down()) {
             m_vely = 4.0f * Get_Vel_Modifier();
         }
 
@@ -1194,7 +1194,7 @@ void cLevel_Player::Start_Jump(float deaccel /* = 0.08f */)
     bool jump_key = 0;
 
     // if jump key pressed
-    if (sf::Keyboard::isKeyPressed(pPreferences->m_key_jump) || pJoystick->Button(pPreferences->m_joy_button_jump)) {
+    if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_jump) || pJoystick->Button(pPreferences->m_joy_button_jump)) {
         jump_key = 1;
     }
 
@@ -1277,7 +1277,7 @@ void cLevel_Player::Update_Jump(void)
     }
 
     // jumping physics
-    if (sf::Keyboard::isKeyPressed(pPreferences->m_key_jump) || pJoystick->Button(pPreferences->m_joy_button_jump)) {
+    if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_jump) || pJoystick->Button(pPreferences->m_joy_button_jump)) {
         Add_Velocity_Y(-(m_jump_accel_up + (m_vely * m_jump_vel_deaccel) / Get_Vel_Modifier()));
         m_jump_power -= pFramerate->m_speed_factor;
     }
@@ -1287,7 +1287,7 @@ void cLevel_Player::Update_Jump(void)
     }
 
     // left right physics
-    if ((sf::Keyboard::isKeyPressed(pPreferences->m_key_left) || pJoystick->Left()) && !m_ducked_counter) {
+    if ((pKeyboard->Is_Key_Pressed(pPreferences->m_key_left) || pJoystick->Left()) && !m_ducked_counter) {
         const float max_vel = -10.0f * Get_Vel_Modifier();
 
         if (m_velx > max_vel) {
@@ -1295,7 +1295,7 @@ void cLevel_Player::Update_Jump(void)
         }
 
     }
-    else if ((sf::Keyboard::isKeyPressed(pPreferences->m_key_right) || pJoystick->Right()) && !m_ducked_counter) {
+    else if ((pKeyboard->Is_Key_Pressed(pPreferences->m_key_right) || pJoystick->Right()) && !m_ducked_counter) {
         const float max_vel = 10.0f * Get_Vel_Modifier();
 
         if (m_velx < max_vel) {
@@ -1360,7 +1360,7 @@ void cLevel_Player::Update_Item(void)
     }
 
     // if control is pressed search for items in front of the player
-    if (sf::Keyboard::isKeyPressed(pPreferences->m_key_action) || pJoystick->Button(pPreferences->m_joy_button_action)) {
+    if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_action) || pJoystick->Button(pPreferences->m_joy_button_action)) {
         // next position velocity with extra size
         float check_x = (m_velx > 0.0f) ? (m_velx + 5.0f) : (m_velx - 5.0f);
 
@@ -2881,7 +2881,7 @@ float cLevel_Player::Get_Vel_Modifier(void) const
     float vel_mod = 1.0f;
 
     // if running key is pressed or always run
-    if (pPreferences->m_always_run || sf::Keyboard::isKeyPressed(pPreferences->m_key_action) || pJoystick->Button(pPreferences->m_joy_button_action)) {
+    if (pPreferences->m_always_run || pKeyboard->Is_Key_Pressed(pPreferences->m_key_action) || pJoystick->Button(pPreferences->m_joy_button_action)) {
         vel_mod = 1.5f;
     }
 
@@ -3195,7 +3195,7 @@ void cLevel_Player::Action_Stop_Interact(input_identifier key_type)
     // Left
     else if (key_type == INP_LEFT) {
         // if key in opposite direction is still pressed only change direction
-        if (sf::Keyboard::isKeyPressed(pPreferences->m_key_right) || pJoystick->Right()) {
+        if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_right) || pJoystick->Right()) {
             m_direction = DIR_RIGHT;
         }
         else {
@@ -3205,7 +3205,7 @@ void cLevel_Player::Action_Stop_Interact(input_identifier key_type)
     // Right
     else if (key_type == INP_RIGHT) {
         // if key in opposite direction is still pressed only change direction
-        if (sf::Keyboard::isKeyPressed(pPreferences->m_key_left) || pJoystick->Left()) {
+        if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_left) || pJoystick->Left()) {
             m_direction = DIR_LEFT;
         }
         else {
@@ -3533,7 +3533,7 @@ Col_Valid_Type cLevel_Player::Validate_Collision(cSprite* obj)
     }
     else if (obj->m_massive_type == MASS_HALFMASSIVE) {
         // fall through
-        if (sf::Keyboard::isKeyPressed(pPreferences->m_key_down) || pJoystick->Down()) {
+        if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_down) || pJoystick->Down()) {
             return COL_VTYPE_NOT_VALID;
         }
 
@@ -3581,22 +3581,22 @@ Col_Valid_Type cLevel_Player::Validate_Collision(cSprite* obj)
             // warp levelexit key check
             if (levelexit->m_exit_type == LEVEL_EXIT_WARP) {
                 // joystick events are sent as keyboard keys
-                if (sf::Keyboard::isKeyPressed(pPreferences->m_key_up) || pJoystick->Up()) {
+                if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_up) || pJoystick->Up()) {
                     if (levelexit->m_start_direction == DIR_UP) {
                         Action_Interact(INP_UP);
                     }
                 }
-                else if (sf::Keyboard::isKeyPressed(pPreferences->m_key_down) || pJoystick->Down()) {
+                else if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_down) || pJoystick->Down()) {
                     if (levelexit->m_start_direction == DIR_DOWN) {
                         Action_Interact(INP_DOWN);
                     }
                 }
-                else if (sf::Keyboard::isKeyPressed(pPreferences->m_key_right) || pJoystick->Right()) {
+                else if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_right) || pJoystick->Right()) {
                     if (levelexit->m_start_direction == DIR_RIGHT) {
                         Action_Interact(INP_RIGHT);
                     }
                 }
-                else if (sf::Keyboard::isKeyPressed(pPreferences->m_key_left) || pJoystick->Left()) {
+                else if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_left) || pJoystick->Left()) {
                     if (levelexit->m_start_direction == DIR_LEFT) {
                         Action_Interact(INP_LEFT);
                     }
@@ -3764,7 +3764,7 @@ void cLevel_Player::Handle_Collision_Massive(cObjectCollision* collision)
     // climbable
     if (col_obj->m_massive_type == MASS_CLIMBABLE && m_state != STA_CLIMB && m_state != STA_FLY) {
         // if not climbing and player wants to climb
-        if (sf::Keyboard::isKeyPressed(pPreferences->m_key_up) || pJoystick->Up() || ((sf::Keyboard::isKeyPressed(pPreferences->m_key_down) || pJoystick->Down()) && !m_ground_object)) {
+        if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_up) || pJoystick->Up() || ((pKeyboard->Is_Key_Pressed(pPreferences->m_key_down) || pJoystick->Down()) && !m_ground_object)) {
             // start climbing
             Start_Climbing();
         }
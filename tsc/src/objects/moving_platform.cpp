@@ -117,6 +117,7 @@ void cMoving_Platform::Init(void)
     m_can_be_on_ground = 0;
 
     m_camera_range = 3000;
+    m_always_active = 1;
     m_can_be_ground = 1;
 
     m_move_type = MOVING_PLATFORM_TYPE_LINE;
@@ -794,6 +795,8 @@ void cMoving_Platform::Update_Rect(void)
     // set height
     m_col_rect.m_h = m_rect.m_h;
     m_start_rect.m_h = m_rect.m_h;
+
+    Update_Spatial_Hash();
 }
 
 void cMoving_Platform::Update_Velocity(void)
@@ -31,6 +31,271 @@
 
 namespace TSC {
 
+/* *** *** *** *** *** *** *** Swept collision *** *** *** *** *** *** *** *** *** *** */
+
+// check key for objects which are not touched anymore
+static const unsigned int col_sweep_no_key = UINT_MAX - 1;
+// check key for objects removed from the checks
+static const unsigned int col_sweep_removed_key = UINT_MAX;
+
+/* One axis of a movement in steps
+ * the position after a given number of checks is calculated directly
+ * so that it is not needed to step through all checks
+*/
+struct cCol_Sweep_Axis {
+    void Init(float pos, float col_offset, float step, float final_pos)
+    {
+        m_pos = pos;
+        m_col_offset = col_offset;
+        m_step = step;
+        m_final = final_pos;
+        m_blocked = 0;
+
+        // not moving
+        if (Is_Float_Equal(step, 0.0f)) {
+            m_step = 0.0f;
+            m_final = pos;
+            m_steps = 0;
+            return;
+        }
+
+        double estimate = ceil((static_cast<double>(final_pos) - pos) / step);
+
+        // also catches NaN
+        if (!(estimate >= 1.0)) {
+            estimate = 1.0;
+        }
+        else if (estimate > 1000000.0) {
+            estimate = 1000000.0;
+        }
+
+        m_steps = static_cast<unsigned int>(estimate);
+
+        // the float math can differ by one
+        while (m_steps > 1 && Is_Final(m_steps - 1)) {
+            m_steps--;
+        }
+        while (!Is_Final(m_steps) && m_steps < 1000000) {
+            m_steps++;
+        }
+    }
+
+    // Returns true if the given number of steps reaches the final position
+    inline bool Is_Final(unsigned int steps) const
+    {
+        const float pos = m_pos + steps * m_step;
+
+        return (m_step > 0.0f && m_final <= pos) || (m_step < 0.0f && m_final >= pos);
+    }
+
+    // Return the last check on this axis
+    inline unsigned int Get_Last_Check(void) const
+    {
+        return m_blocked ? m_blocked : m_steps;
+    }
+
+    // Return the number of checks after which the position does not change anymore
+    inline unsigned int Get_Linear_End(void) const
+    {
+        return m_blocked ? m_blocked - 1 : m_steps;
+    }
+
+    // Return the position after the given number of checks
+    inline float Get_Pos(unsigned int checks) const
+    {
+        if (m_blocked && checks >= m_blocked) {
+            checks = m_blocked - 1;
+        }
+
+        if (checks >= m_steps) {
+            return m_final;
+        }
+
+        return m_pos + checks * m_step;
+    }
+
+    // Return the collision rect position after the given number of checks
+    inline float Get_Col_Pos(unsigned int checks) const
+    {
+        return Get_Pos(checks) + m_col_offset;
+    }
+
+    // Return the collision rect position tested by the given check
+    inline float Get_Check_Pos(unsigned int check) const
+    {
+        return Get_Col_Pos(check - 1) + m_step;
+    }
+
+    // position at the start
+    float m_pos;
+    // collision rect offset to the position
+    float m_col_offset;
+    float m_step;
+    float m_final;
+    // checks needed to reach the final position
+    unsigned int m_steps;
+    // check which found a blocking collision or 0
+    unsigned int m_blocked;
+};
+
+/* Calculate the check range in which the moving range touches the given range
+ * the moving range is [start + check * step, start + check * step + size]
+ * returns false if it never touches
+*/
+static bool Col_Sweep_Range(double start, double step, double size, double col_start, double col_end, double& check_min, double& check_max)
+{
+    // offsets needed to touch
+    const double lower = col_start - size - start;
+    const double upper = col_end - start;
+
+    // not moving
+    if (step == 0.0) {
+        if (lower <= 0.0 && upper >= 0.0) {
+            check_min = -DBL_MAX;
+            check_max = DBL_MAX;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    if (step > 0.0) {
+        check_min = lower / step;
+        check_max = upper / step;
+    }
+    else {
+        check_min = upper / step;
+        check_max = lower / step;
+    }
+
+    return check_min <= check_max;
+}
+
+// Returns true if the collision rect tested by the given check touches the object rect
+static bool Col_Sweep_Touches(const cCol_Sweep_Axis& axis_x, const cCol_Sweep_Axis& axis_y, float w, float h, bool vertical, unsigned int check, const GL_rect& obj_rect)
+{
+    // vertical checks are done after the horizontal move of the same step
+    if (vertical) {
+        return GL_rect(axis_x.Get_Col_Pos(check), axis_y.Get_Check_Pos(check), w, h).Intersects(obj_rect);
+    }
+
+    return GL_rect(axis_x.Get_Check_Pos(check), axis_y.Get_Col_Pos(check - 1), w, h).Intersects(obj_rect);
+}
+
+/* Return the first check on the given axis from first_check on which touches the object rect
+ * returns 0 if none
+*/
+static unsigned int Col_Sweep_First_Touch(const cCol_Sweep_Axis& axis_x, const cCol_Sweep_Axis& axis_y, float w, float h, bool vertical, unsigned int first_check, const GL_rect& obj_rect)
+{
+    const cCol_Sweep_Axis& moving = vertical ? axis_y : axis_x;
+    const cCol_Sweep_Axis& other = vertical ? axis_x : axis_y;
+    const unsigned int last_check = moving.Get_Last_Check();
+
+    if (first_check < 1) {
+        first_check = 1;
+    }
+
+    // not moving or already finished
+    if (!moving.m_steps || first_check > last_check) {
+        return 0;
+    }
+
+    double check_min, check_max;
+
+    // the moving axis never touches
+    if (vertical) {
+        if (!Col_Sweep_Range(moving.m_pos + moving.m_col_offset, moving.m_step, h, obj_rect.m_y, obj_rect.m_y + obj_rect.m_h, check_min, check_max)) {
+            return 0;
+        }
+    }
+    else if (!Col_Sweep_Range(moving.m_pos + moving.m_col_offset, moving.m_step, w, obj_rect.m_x, obj_rect.m_x + obj_rect.m_w, check_min, check_max)) {
+        return 0;
+    }
+
+    /* the other axis is linear up to this check and constant after it
+     * horizontal checks use the vertical position of the previous step
+    */
+    const long other_linear_last = vertical ? static_cast<long>(other.Get_Linear_End()) - 1 : static_cast<long>(other.Get_Linear_End());
+    const double other_start = vertical ? other.m_pos + other.m_col_offset : other.m_pos + other.m_col_offset - other.m_step;
+    const double other_size = vertical ? w : h;
+    const double other_col_start = vertical ? obj_rect.m_x : obj_rect.m_y;
+    const double other_col_end = vertical ? obj_rect.m_x + obj_rect.m_w : obj_rect.m_y + obj_rect.m_h;
+
+    for (unsigned int part = 0; part < 2; part++) {
+        long range_first = first_check;
+        long range_last = last_check;
+        double other_min = -DBL_MAX;
+        double other_max = DBL_MAX;
+
+        // linear part
+        if (part == 0) {
+            range_last = std::min(range_last, other_linear_last);
+
+            if (range_first > range_last || !Col_Sweep_Range(other_start, other.m_step, other_size, other_col_start, other_col_end, other_min, other_max)) {
+                continue;
+            }
+        }
+        // constant part
+        else {
+            range_first = std::max(range_first, other_linear_last + 1);
+
+            if (range_first > range_last) {
+                continue;
+            }
+
+            const double other_pos = vertical ? axis_x.Get_Col_Pos(range_first) : axis_y.Get_Col_Pos(range_first - 1);
+
+            if (other_pos > other_col_end || other_pos + other_size < other_col_start) {
+                continue;
+            }
+        }
+
+        const double lower = std::max(std::max(check_min, other_min), static_cast<double>(range_first));
+        const double upper = std::min(std::min(check_max, other_max), static_cast<double>(range_last));
+
+        if (lower > upper + 1.0) {
+            continue;
+        }
+
+        // confirm with the real rects as the float math can differ by one
+        long check = static_cast<long>(ceil(lower));
+
+        if (check > range_first) {
+            check--;
+        }
+
+        for (const long end = std::min(check + 3, range_last + 1); check < end; check++) {
+            if (Col_Sweep_Touches(axis_x, axis_y, w, h, vertical, check, obj_rect)) {
+                return check;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Return the key of the first check from the given key on which touches the object rect
+ * the key of a check is two times the step plus one if vertical
+*/
+static unsigned int Col_Sweep_Next_Touch(const cCol_Sweep_Axis& axis_x, const cCol_Sweep_Axis& axis_y, float w, float h, unsigned int first_key, const GL_rect& obj_rect)
+{
+    unsigned int key = col_sweep_no_key;
+
+    unsigned int check = Col_Sweep_First_Touch(axis_x, axis_y, w, h, 0, (first_key + 1) / 2, obj_rect);
+
+    if (check) {
+        key = check * 2;
+    }
+
+    check = Col_Sweep_First_Touch(axis_x, axis_y, w, h, 1, first_key / 2, obj_rect);
+
+    if (check && check * 2 + 1 < key) {
+        key = check * 2 + 1;
+    }
+
+    return key;
+}
+
 /* *** *** *** *** *** *** *** cMovingSprite *** *** *** *** *** *** *** *** *** *** */
 
 cMovingSprite::cMovingSprite(cSprite_Manager* sprite_manager, std::string type_name /* = "sprite" */)
@@ -228,7 +493,7 @@ void cMovingSprite::Move(float move_x, float move_y, bool real /* = 0 */)
     Check_And_Handle_Out_Of_Level(move_x, move_y);
 }
 
-cObjectCollisionType* cMovingSprite::Col_Move_in_Steps(float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List sprite_list, bool stop_on_internal /* = 0 */)
+cObjectCollisionType* cMovingSprite::Col_Move_in_Steps(float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List& sprite_list, bool stop_on_internal /* = 0 */)
 {
     if (sprite_list.empty()) {
         cSprite::Move(final_pos_x - m_pos_x, final_pos_y - m_pos_y, 1);
@@ -403,6 +668,147 @@ cObjectCollisionType* cMovingSprite::Col_Move_in_Steps(float move_x, float move_
     return col_list;
 }
 
+cObjectCollisionType* cMovingSprite::Col_Sweep_in_Steps(float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List& sprite_list, bool stop_on_internal /* = 0 */)
+{
+    if (sprite_list.empty()) {
+        cSprite::Move(final_pos_x - m_pos_x, final_pos_y - m_pos_y, 1);
+        return NULL;
+    }
+
+    // collision list
+    cObjectCollisionType* col_list = new cObjectCollisionType();
+
+    // no width or height never collides
+    if (Is_Float_Equal(m_col_rect.m_w, 0.0f) || Is_Float_Equal(m_col_rect.m_h, 0.0f)) {
+        cSprite::Move(final_pos_x - m_pos_x, final_pos_y - m_pos_y, 1);
+        return col_list;
+    }
+
+    cCol_Sweep_Axis axis_x;
+    cCol_Sweep_Axis axis_y;
+    axis_x.Init(m_pos_x, m_col_pos.m_x, step_size_x, final_pos_x);
+    axis_y.Init(m_pos_y, m_col_pos.m_y, step_size_y, final_pos_y);
+
+    const float col_w = m_col_rect.m_w;
+    const float col_h = m_col_rect.m_h;
+
+    /* next touching check key of each object
+     * smaller than the current key if it needs to be calculated again
+    */
+    vector<unsigned int> touch_keys;
+    touch_keys.swap(m_col_sweep_keys);
+    touch_keys.assign(sprite_list.size(), 0);
+
+    size_t objects_left = sprite_list.size();
+    // the first check is horizontal
+    unsigned int check_key = 2;
+
+    while (objects_left) {
+        unsigned int next_key = col_sweep_no_key;
+
+        // get the next check which touches an object
+        for (size_t i = 0; i < sprite_list.size(); i++) {
+            if (touch_keys[i] == col_sweep_removed_key) {
+                continue;
+            }
+
+            if (touch_keys[i] < check_key) {
+                touch_keys[i] = Col_Sweep_Next_Touch(axis_x, axis_y, col_w, col_h, check_key, sprite_list[i]->m_col_rect);
+            }
+
+            if (touch_keys[i] < next_key) {
+                next_key = touch_keys[i];
+            }
+        }
+
+        // no more collisions
+        if (next_key == col_sweep_no_key) {
+            break;
+        }
+
+        const unsigned int check = next_key / 2;
+        const bool vertical = next_key % 2;
+
+        // set the position before the check for validation and the collision direction
+        m_pos_x = axis_x.Get_Pos(vertical ? check : check - 1);
+        m_pos_y = axis_y.Get_Pos(check - 1);
+        Update_Position_Rect();
+
+        bool collision_found = 0;
+
+        for (size_t i = 0; i < sprite_list.size(); i++) {
+            if (touch_keys[i] != next_key) {
+                continue;
+            }
+
+            cSprite* level_object = sprite_list[i];
+
+            // the same as ignored by Collision_Check()
+            if (this == level_object || level_object->m_auto_destroy || level_object->m_sprite_array == ARRAY_UNDEFINED || level_object->m_sprite_array == ARRAY_HUD || level_object->m_sprite_array == ARRAY_ANIM ||
+                (level_object->m_sprite_array == ARRAY_ENEMY && static_cast<cEnemy*>(level_object)->m_dead)) {
+                touch_keys[i] = col_sweep_removed_key;
+                objects_left--;
+                continue;
+            }
+
+            // validate
+            Col_Valid_Type col_valid = Validate_Collision(level_object);
+
+            // not a valid collision, check again on the next touch
+            if (col_valid == COL_VTYPE_NOT_VALID) {
+                touch_keys[i] = 0;
+                continue;
+            }
+
+            col_list->Add(Create_Collision_Object(this, level_object, col_valid));
+
+            // stop on everything
+            if (stop_on_internal || col_valid == COL_VTYPE_BLOCKING) {
+                collision_found = 1;
+            }
+        }
+
+        // stop moving on this axis
+        if (collision_found) {
+            if (vertical) {
+                axis_y.m_blocked = check;
+            }
+            else {
+                axis_x.m_blocked = check;
+            }
+
+            // the path changed
+            for (size_t i = 0; i < touch_keys.size(); i++) {
+                if (touch_keys[i] != col_sweep_removed_key) {
+                    touch_keys[i] = 0;
+                }
+            }
+        }
+        // remove internal collision from further checks
+        else if (!stop_on_internal) {
+            for (size_t i = 0; i < touch_keys.size(); i++) {
+                if (touch_keys[i] == next_key) {
+                    touch_keys[i] = col_sweep_removed_key;
+                    objects_left--;
+                }
+            }
+        }
+
+        check_key = next_key + 1;
+    }
+
+    // final position
+    m_pos_x = axis_x.Get_Pos(axis_x.m_steps);
+    m_pos_y = axis_y.Get_Pos(axis_y.m_steps);
+    Update_Position_Rect();
+
+    // keep the list memory for the next move
+    touch_keys.clear();
+    m_col_sweep_keys.swap(touch_keys);
+
+    return col_list;
+}
+
 void cMovingSprite::Col_Move(float move_x, float move_y, bool real /* = 0 */, bool force /* = 0 */, bool check_on_ground /* = 1 */)
 {
     // no need to move
@@ -442,7 +848,11 @@ void cMovingSprite::Col_Move(float move_x, float move_y, bool real /* = 0 */, bo
             complete_rect.m_h -= move_y;
         }
 
+        // reuse the list memory
         cSprite_List sprite_list;
+        sprite_list.swap(m_col_move_objects);
+        sprite_list.clear();
+
         m_sprite_manager->Get_Colliding_Objects(sprite_list, complete_rect, 1, this);
 
         // step size
@@ -467,8 +877,11 @@ void cMovingSprite::Col_Move(float move_x, float move_y, bool real /* = 0 */, bo
         float final_pos_x = m_pos_x + move_x;
         float final_pos_y = m_pos_y + move_y;
 
+        // calculate the steps directly or check each one
+        const bool swept = pPreferences->m_swept_collision;
+
         // move in big steps
-        cObjectCollisionType* col_list = Col_Move_in_Steps(move_x, move_y, step_size_x, step_size_y, final_pos_x, final_pos_y, sprite_list, 1);
+        cObjectCollisionType* col_list = swept ? Col_Sweep_in_Steps(move_x, move_y, step_size_x, step_size_y, final_pos_x, final_pos_y, sprite_list, 1) : Col_Move_in_Steps(move_x, move_y, step_size_x, step_size_y, final_pos_x, final_pos_y, sprite_list, 1);
 
         // if a collision is found enter pixel checking
         if (col_list && col_list->size()) {
@@ -488,7 +901,7 @@ void cMovingSprite::Col_Move(float move_x, float move_y, bool real /* = 0 */, bo
             }
 
             delete col_list;
-            col_list = Col_Move_in_Steps(move_x, move_y, step_size_x, step_size_y, final_pos_x, final_pos_y, sprite_list);
+            col_list = swept ? Col_Sweep_in_Steps(move_x, move_y, step_size_x, step_size_y, final_pos_x, final_pos_y, sprite_list) : Col_Move_in_Steps(move_x, move_y, step_size_x, step_size_y, final_pos_x, final_pos_y, sprite_list);
 
             Add_Collisions(col_list, 1);
         }
@@ -496,6 +909,8 @@ void cMovingSprite::Col_Move(float move_x, float move_y, bool real /* = 0 */, bo
         if (col_list) {
             delete col_list;
         }
+
+        m_col_move_objects.swap(sprite_list);
     }
     // don't check for collisions
     else {
@@ -708,9 +1123,16 @@ cObjectCollisionType* cMovingSprite::Collision_Check(const GL_rect& new_rect, co
         return col_list;
     }
 
+    // objects touching the rect if no list is given, reuses the list memory
+    cSprite_List rect_objects;
+
     // if no object list is given get all objects available
     if (!objects) {
-        objects = &m_sprite_manager->objects;
+        rect_objects.swap(m_collision_check_objects);
+        rect_objects.clear();
+
+        m_sprite_manager->Get_Colliding_Objects(rect_objects, new_rect, 0, this);
+        objects = &rect_objects;
 
         // Player
         if (m_type != TYPE_PLAYER && new_rect.Intersects(pActive_Player->m_col_rect)) {
@@ -788,6 +1210,11 @@ cObjectCollisionType* cMovingSprite::Collision_Check(const GL_rect& new_rect, co
         col_list->Add(Create_Collision_Object(this, level_object, col_valid));
     }
 
+    // keep the list memory for the next check
+    if (objects == &rect_objects) {
+        m_collision_check_objects.swap(rect_objects);
+    }
+
     return col_list;
 }
 
@@ -305,10 +305,23 @@ namespace TSC {
     private:
         /* moves in steps and checks in both directions simultaneous
          * returns the found collisions
-         * sprite_list : objects to check
+         * sprite_list : objects to check, internal collisions are removed from it if not stop_on_internal
          * stop_on_internal : if set stops moving if internal collision was found
         */
-        cObjectCollisionType* Col_Move_in_Steps(float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List sprite_list, bool stop_on_internal = 0);
+        cObjectCollisionType* Col_Move_in_Steps(float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List& sprite_list, bool stop_on_internal = 0);
+        /* calculates the same result as Col_Move_in_Steps() without checking each step
+         * the first touching step of every object is calculated directly
+         * and only those steps are validated
+        */
+        cObjectCollisionType* Col_Sweep_in_Steps(float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List& sprite_list, bool stop_on_internal = 0);
+
+        /* object lists reused by the collision checks
+         * keeps their memory to not allocate again every frame
+        */
+        cSprite_List m_col_move_objects;
+        cSprite_List m_collision_check_objects;
+        // next touching check of each object used by Col_Sweep_in_Steps()
+        vector<unsigned int> m_col_sweep_keys;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
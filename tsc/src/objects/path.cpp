@@ -477,6 +477,7 @@ void cPath::Init(void)
     m_type = TYPE_PATH;
     m_massive_type = MASS_PASSIVE;
     m_editor_pos_z = 0.11f;
+    m_always_active = 1;
     m_show_line = false;
 
     m_name = _("Path");
@@ -351,6 +351,23 @@ cSprite::cSprite(XmlAttributes& attributes, cSprite_Manager* sprite_manager, con
 
 cSprite::~cSprite(void)
 {
+    // unregister from the collision structures
+    if (m_spatial_hash_entry.m_hash) {
+        m_spatial_hash_entry.m_hash->Remove(this);
+    }
+    if (m_static_tree_entry.m_bvh) {
+        m_static_tree_entry.m_bvh->Remove(this);
+    }
+    if (m_broad_phase_entry.m_broad_phase) {
+        m_broad_phase_entry.m_broad_phase->Remove(this);
+    }
+    if (m_col_rect_cache_entry.m_cache) {
+        m_col_rect_cache_entry.m_cache->Remove(this);
+    }
+    if (m_static_geometry_entry.m_chunk) {
+        cStatic_Geometry::Remove(this);
+    }
+
     if (m_delete_image && m_image) {
         delete m_image;
         m_image = NULL;
@@ -414,6 +431,9 @@ void cSprite::Init(void)
     m_active = 1;
     m_spawned = 0;
     m_camera_range = 1000;
+    m_always_active = 0;
+    m_always_active_set = 0;
+    m_sleeping = 0;
     m_can_be_ground = 0;
     m_disallow_managed_delete = 0;
 
@@ -440,6 +460,8 @@ void cSprite::Init(void)
     m_valid_update = 1;
 
     m_uid = -1;
+    m_manager_array_num = -1;
+    m_manager_destroyed_num = -1;
 }
 
 cSprite* cSprite::Copy(void) const
@@ -500,6 +522,9 @@ xmlpp::Element* cSprite::Save_To_XML_Node(xmlpp::Element* p_element)
     Add_Property(p_node, "posy", static_cast<int>(m_start_pos_y));
     // UID
     Add_Property(p_node, "uid", m_uid);
+    // only if set by the level or a script and not by the object type
+    if (m_always_active_set && m_always_active)
+        Add_Property(p_node, "always_active", m_always_active);
 
     // image
     boost::filesystem::path img_filename;
@@ -687,6 +712,7 @@ void cSprite::Set_Ignore_Camera(bool enable /* = 0 */)
     m_no_camera = enable;
 
     Update_Valid_Draw();
+    Update_Static_Geometry();
 }
 
 void cSprite::Set_Pos(float x, float y, bool new_startpos /* = 0 */)
@@ -735,6 +761,7 @@ void cSprite::Set_Active(bool enabled)
 
     Update_Valid_Draw();
     Update_Valid_Update();
+    Update_Static_Geometry();
 }
 
 /** Set a Color Combination ( GL_ADD, GL_MODULATE or GL_REPLACE ).
@@ -754,6 +781,8 @@ void cSprite::Set_Color_Combine(const float red, const float green, const float
     m_combine_color[0] = Clamp(red, 0.000001f, 1.0f);
     m_combine_color[1] = Clamp(green, 0.000001f, 1.0f);
     m_combine_color[2] = Clamp(blue, 0.000001f, 1.0f);
+
+    Update_Static_Geometry();
 }
 
 void cSprite::Update_Rect_Rotation_Z(void)
@@ -807,6 +836,10 @@ void cSprite::Set_Rotation_X(float rot, bool new_start_rot /* = 0 */)
 
     if (m_rotation_affects_rect) {
         Update_Rect_Rotation_X();
+        Update_Spatial_Hash();
+    }
+    else {
+        Update_Static_Geometry();
     }
 }
 
@@ -820,6 +853,10 @@ void cSprite::Set_Rotation_Y(float rot, bool new_start_rot /* = 0 */)
 
     if (m_rotation_affects_rect) {
         Update_Rect_Rotation_Y();
+        Update_Spatial_Hash();
+    }
+    else {
+        Update_Static_Geometry();
     }
 }
 
@@ -833,6 +870,10 @@ void cSprite::Set_Rotation_Z(float rot, bool new_start_rot /* = 0 */)
 
     if (m_rotation_affects_rect) {
         Update_Rect_Rotation_Z();
+        Update_Spatial_Hash();
+    }
+    else {
+        Update_Static_Geometry();
     }
 }
 void cSprite::Set_Scale_X(const float scale, const bool new_startscale /* = 0 */)
@@ -859,6 +900,8 @@ void cSprite::Set_Scale_X(const float scale, const bool new_startscale /* = 0 */
     if (new_startscale) {
         m_start_scale_x = m_scale_x;
     }
+
+    Update_Spatial_Hash();
 }
 
 void cSprite::Set_Scale_Y(const float scale, const bool new_startscale /* = 0 */)
@@ -885,6 +928,8 @@ void cSprite::Set_Scale_Y(const float scale, const bool new_startscale /* = 0 */
     if (new_startscale) {
         m_start_scale_y = m_scale_y;
     }
+
+    Update_Spatial_Hash();
 }
 void cSprite::Set_On_Top(const cSprite* sprite, bool optimize_hor_pos /* = 1 */)
 {
@@ -940,6 +985,7 @@ void cSprite::Update_Position_Rect(void)
         m_col_rect.m_y = m_pos_y + m_col_pos.m_y;
     }
 
+    Update_Spatial_Hash();
     Update_Valid_Draw();
 }
 
@@ -1062,6 +1108,11 @@ void cSprite::Draw_Image_Normal(cSurface_Request* request /* = NULL */) const
 {
     // texture id
     request->m_texture_id = m_image->m_image;
+    // texture coordinates
+    request->m_tex_left = m_image->m_tex_left;
+    request->m_tex_top = m_image->m_tex_top;
+    request->m_tex_right = m_image->m_tex_right;
+    request->m_tex_bottom = m_image->m_tex_bottom;
 
     // size
     request->m_w = m_image->m_start_w;
@@ -1148,12 +1199,20 @@ void cSprite::Draw_Image_Normal(cSurface_Request* request /* = NULL */) const
         request->m_shadow_pos = m_shadow_pos;
         request->m_shadow_color = m_shadow_color;
     }
+
+    // drawn in the opaque pass if nothing makes it translucent
+    request->m_opaque = m_image->m_opaque && m_color.alpha == 255 && !m_combine_type;
 }
 
 void cSprite::Draw_Image_Editor(cSurface_Request* request /* = NULL */) const
 {
     // texture id
     request->m_texture_id = m_start_image->m_image;
+    // texture coordinates
+    request->m_tex_left = m_start_image->m_tex_left;
+    request->m_tex_top = m_start_image->m_tex_top;
+    request->m_tex_right = m_start_image->m_tex_right;
+    request->m_tex_bottom = m_start_image->m_tex_bottom;
 
     // size
     request->m_w = m_start_image->m_start_w;
@@ -1246,6 +1305,9 @@ void cSprite::Draw_Image_Editor(cSurface_Request* request /* = NULL */) const
         request->m_shadow_pos = m_shadow_pos;
         request->m_shadow_color = m_shadow_color;
     }
+
+    // drawn in the opaque pass if nothing makes it translucent
+    request->m_opaque = m_start_image->m_opaque && m_color.alpha == 255 && !m_combine_type;
 }
 
 /**
@@ -1284,6 +1346,9 @@ void cSprite::Set_Massive_Type(MassiveType type)
         m_can_be_ground = false;
     }
 
+    // it may no longer be cached
+    Update_Static_Geometry();
+
     // make it the latest sprite
     m_sprite_manager->Move_To_Back(this);
 }
@@ -1365,6 +1430,20 @@ bool cSprite::Is_Update_Valid()
 }
 
 bool cSprite::Is_Draw_Valid(void)
+{
+    if (!Is_Image_Drawable()) {
+        return 0;
+    }
+
+    // not visible on the screen
+    if (!Is_Visible_On_Screen()) {
+        return 0;
+    }
+
+    return 1;
+}
+
+bool cSprite::Is_Image_Drawable(void) const
 {
     // if editor not enabled
     if (!editor_enabled) {
@@ -1386,11 +1465,6 @@ bool cSprite::Is_Draw_Valid(void)
         }
     }
 
-    // not visible on the screen
-    if (!Is_Visible_On_Screen()) {
-        return 0;
-    }
-
     return 1;
 }
 
@@ -1413,6 +1487,16 @@ void cSprite::Destroy(void)
     m_valid_draw = 0;
     m_valid_update = 0;
     Set_Image(NULL, 1);
+
+    if (m_col_rect_cache_entry.m_cache) {
+        m_col_rect_cache_entry.m_cache->Update(this);
+    }
+
+    Update_Static_Geometry();
+
+    if (m_sprite_manager) {
+        m_sprite_manager->Add_Destroyed(this);
+    }
 }
 
 #ifdef ENABLE_EDITOR
@@ -22,6 +22,11 @@
 #include "../video/video.hpp"
 #include "../video/img_set.hpp"
 #include "../core/collision.hpp"
+#include "../core/spatial_hash.hpp"
+#include "../core/sprite_bvh.hpp"
+#include "../core/col_rect_cache.hpp"
+#include "../core/sort_and_sweep.hpp"
+#include "../video/static_geometry.hpp"
 #include "../scripting/scriptable_object.hpp"
 #include "../scripting/scripting.hpp"
 #include "../scripting/objects/sprites/mrb_sprite.hpp"
@@ -190,11 +195,13 @@ namespace TSC {
         inline void Set_Shadow_Pos(const float pos)
         {
             m_shadow_pos = pos;
+            Update_Static_Geometry();
         };
         // Set the shadow color
         inline void Set_Shadow_Color(const Color& shadow)
         {
             m_shadow_color = shadow;
+            Update_Static_Geometry();
         };
         // Set image color
         inline void Set_Color(const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t alpha = 255)
@@ -203,10 +210,12 @@ namespace TSC {
             m_color.green = green;
             m_color.blue = blue;
             m_color.alpha = alpha;
+            Update_Static_Geometry();
         };
         inline void Set_Color(const Color& col)
         {
             m_color = col;
+            Update_Static_Geometry();
         };
 
         /// Set a Color Combination ( GL_ADD, GL_MODULATE or GL_REPLACE )
@@ -308,6 +317,7 @@ namespace TSC {
             m_scale_down = down;
             m_scale_left = left;
             m_scale_right = right;
+            Update_Static_Geometry();
         };
         // Set the scale
         void Set_Scale_X(const float scale, const bool new_startscale = 0);
@@ -356,6 +366,39 @@ namespace TSC {
 
         // Update the position rect values
         void Update_Position_Rect(void);
+        /* Update the collision rect cells in the spatial hash
+         * a static sprite leaving its tree bounds becomes dynamic
+         * and leaving the broad phase bounds is checked with every query
+         * must be called if m_col_rect changed without Update_Position_Rect()
+        */
+        inline void Update_Spatial_Hash(void)
+        {
+            if (m_col_rect_cache_entry.m_cache) {
+                m_col_rect_cache_entry.m_cache->Update(this);
+            }
+
+            if (m_spatial_hash_entry.m_hash) {
+                m_spatial_hash_entry.m_hash->Update(this);
+            }
+            else if (m_static_tree_entry.m_bvh && !m_static_tree_entry.m_bvh->Is_Inside(this)) {
+                m_static_tree_entry.m_bvh->Promote(this);
+            }
+
+            if (m_broad_phase_entry.m_broad_phase) {
+                m_broad_phase_entry.m_broad_phase->Check_Bounds(this);
+            }
+
+            Update_Static_Geometry();
+        }
+        /* Bake the cached image again
+         * must be called if the drawn image changed without a setter
+        */
+        inline void Update_Static_Geometry(void)
+        {
+            if (m_static_geometry_entry.m_chunk) {
+                m_static_geometry_entry.m_chunk->m_dirty = 1;
+            }
+        }
         // default update, derived updates should not call this again if they also call Update_Animation()
         virtual void Update(void) { Update_Animation(); };
         /* late update
@@ -400,6 +443,8 @@ namespace TSC {
         virtual bool Is_Update_Valid();
         // if draw is valid for the current state and position
         virtual bool Is_Draw_Valid(void);
+        // if the image is drawn when visible on the screen
+        bool Is_Image_Drawable(void) const;
 
         // returns true if this is a basic sprite type
         inline bool Is_Basic_Sprite(void) const
@@ -536,6 +581,12 @@ namespace TSC {
         bool m_spawned;
         /// maximum distance to the camera to get updated
         unsigned int m_camera_range;
+        /// never put to sleep outside the activation region ( paths, moving platforms, set from level XML or scripts )
+        bool m_always_active;
+        /// if m_always_active was set by the level or a script and is saved
+        bool m_always_active_set;
+        /// outside the activation region and not updated
+        bool m_sleeping;
         /// can be used as ground object
         bool m_can_be_ground;
 
@@ -562,6 +613,21 @@ namespace TSC {
         /// ID to uniquely identify this sprite (UIDS[idhere] uses this)
         int m_uid;
 
+        /// registered cells in the sprite manager spatial hash
+        cSpatial_Hash_Entry m_spatial_hash_entry;
+        /// item in the sprite manager static sprite tree
+        cSprite_BVH_Entry m_static_tree_entry;
+        /// item in the sprite manager collision broad phase
+        cSort_And_Sweep_Entry m_broad_phase_entry;
+        /// slot in the sprite manager collision rect cache
+        cCol_Rect_Cache_Entry m_col_rect_cache_entry;
+        /// chunk in the sprite manager static geometry cache
+        cStatic_Geometry_Entry m_static_geometry_entry;
+        /// position in the sprite manager objects array or -1 if not managed
+        int m_manager_array_num;
+        /// position in the sprite manager destroyed objects list or -1 if not in it
+        int m_manager_destroyed_num;
+
         static const float m_pos_z_passive_start; ///< Start Z position for passive elements
         static const float m_pos_z_massive_start; ///< Start Z position for massive elements
         static const float m_pos_z_front_passive_start; ///< Start Z position for front passive elements
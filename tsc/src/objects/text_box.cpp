@@ -178,11 +178,11 @@ void cText_Box::Activate(void)
         }
 
         // down
-        if (sf::Keyboard::isKeyPressed(pPreferences->m_key_down) || pJoystick->Down()) {
+        if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_down) || pJoystick->Down()) {
             editbox->getVertScrollbar()->setScrollPosition(editbox->getVertScrollbar()->getScrollPosition() + (editbox->getVertScrollbar()->getStepSize() * 0.25f * pFramerate->m_speed_factor));
         }
         // up
-        if (sf::Keyboard::isKeyPressed(pPreferences->m_key_up) || pJoystick->Up()) {
+        if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_up) || pJoystick->Up()) {
             editbox->getVertScrollbar()->setScrollPosition(editbox->getVertScrollbar()->getScrollPosition() - (editbox->getVertScrollbar()->getStepSize() * 0.25f * pFramerate->m_speed_factor));
         }
 
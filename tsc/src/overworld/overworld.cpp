@@ -482,16 +482,16 @@ void cOverworld::Update_Camera(void)
 
     // todo : move to a Process_Input function
     if (pOverworld_Manager->m_camera_mode) {
-        if (sf::Keyboard::isKeyPressed(pPreferences->m_key_right) || pJoystick->Right()) {
+        if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_right) || pJoystick->Right()) {
             pOverworld_Manager->m_camera->Move(pFramerate->m_speed_factor * 15, 0);
         }
-        else if (sf::Keyboard::isKeyPressed(pPreferences->m_key_left) || pJoystick->Left()) {
+        else if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_left) || pJoystick->Left()) {
             pOverworld_Manager->m_camera->Move(pFramerate->m_speed_factor * -15, 0);
         }
-        if (sf::Keyboard::isKeyPressed(pPreferences->m_key_up) || pJoystick->Up()) {
+        if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_up) || pJoystick->Up()) {
             pOverworld_Manager->m_camera->Move(0, pFramerate->m_speed_factor * -15);
         }
-        else if (sf::Keyboard::isKeyPressed(pPreferences->m_key_down) || pJoystick->Down()) {
+        else if (pKeyboard->Is_Key_Pressed(pPreferences->m_key_down) || pJoystick->Down()) {
             pOverworld_Manager->m_camera->Move(0, pFramerate->m_speed_factor * 15);
         }
     }
@@ -545,7 +545,7 @@ bool cOverworld::Key_Down(const sf::Event& evt)
         // toggle layer drawing
         pOverworld_Manager->m_draw_layer = !pOverworld_Manager->m_draw_layer;
     }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::G) && sf::Keyboard::isKeyPressed(sf::Keyboard::O) && sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
+    else if (pKeyboard->Is_Key_Pressed(sf::Keyboard::G) && pKeyboard->Is_Key_Pressed(sf::Keyboard::O) && pKeyboard->Is_Key_Pressed(sf::Keyboard::D)) {
         // all waypoint access
         for (cWaypoint* waypoint: m_waypoints) {
             waypoint->Set_Access(true);
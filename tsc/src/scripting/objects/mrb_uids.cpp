@@ -37,12 +37,9 @@
  *
  * The `UIDS` module maintains a cache for the sprite objects so that it
  * doesn’t have to create MRuby objects for all the sprites right at the
- * beginning of a level, but rather when you first access them. This means
- * that while level loading is fast, referencing a bunch of not-yet-seen
- * sprites will probably cause a noticable pause in the gameplay, so be
- * careful when doing this. After a sprite has first been mapped to MRuby
- * land, referencing it will just cause a lookup in the internal cache
- * and therefore is quite fast.
+ * beginning of a level, but rather when you first access them. After a
+ * sprite has first been mapped to MRuby land, referencing it will just
+ * cause a lookup in the internal cache.
  */
 
 using namespace TSC;
@@ -66,21 +63,23 @@ static mrb_value _Index(mrb_state* p_state, mrb_value cache, mrb_value ruid)
 
     // Otherwise, allocate a new MRuby object for it and store
     // that new object in the cache.
-    cSprite_List objs = pActive_Level->m_sprite_manager->objects; // Shorthand
     mrb_int uid = mrb_fixnum(ruid);
-    for (cSprite_List::const_iterator iter = objs.begin(); iter != objs.end(); iter++) {
-        if ((*iter)->m_uid == uid) {
-            // Ask the sprite to create the correct type of MRuby object
-            // so we don’t have to maintain a static C++/MRuby type mapping table
-            mrb_value obj = (*iter)->Create_MRuby_Object(p_state);
-            // Store it in the cache
-            mrb_hash_set(p_state, cache, ruid, obj);
-
-            return obj;
-        }
-    }
 
-    return mrb_nil_value();
+    // UIDs are ints, anything else can't be found
+    if (uid < INT_MIN || uid > INT_MAX)
+        return mrb_nil_value();
+
+    cSprite* p_sprite = pActive_Level->m_sprite_manager->Get_by_UID(static_cast<int>(uid));
+    if (!p_sprite)
+        return mrb_nil_value();
+
+    // Ask the sprite to create the correct type of MRuby object
+    // so we don’t have to maintain a static C++/MRuby type mapping table
+    mrb_value obj = p_sprite->Create_MRuby_Object(p_state);
+    // Store it in the cache
+    mrb_hash_set(p_state, cache, ruid, obj);
+
+    return obj;
 }
 
 /**
@@ -92,9 +91,8 @@ static mrb_value _Index(mrb_state* p_state, mrb_value cache, mrb_value ruid)
  *
  * Retrieve an MRuby object for the sprite with the unique identifier
  * `uid`. The first time you call this method with a given UID, it
- * will cycle through _all_ sprite objects in the level, so it will
- * take relatively long. The sprite object is then cached internally,
- * causing later lookups to be fast.
+ * creates the MRuby object for the sprite. The sprite object is then
+ * cached internally, causing later lookups to be faster.
  *
  * #### Parameters
  * uid
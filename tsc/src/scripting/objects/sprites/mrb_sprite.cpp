@@ -634,6 +634,44 @@ static mrb_value Is_Active(mrb_state* p_state, mrb_value self)
     return mrb_bool_value(p_sprite->m_active);
 }
 
+/**
+ * Method: Sprite#always_active=
+ *
+ *   always_active=( bool ) → bool
+ *
+ * If set to true, the sprite is never put to sleep when it is
+ * far away from the camera. Use this for sprites you control from
+ * timers or via `UIDS[]` without registering event handlers on
+ * them, as sleeping sprites are not updated.
+ */
+static mrb_value Set_Always_Active(mrb_state* p_state, mrb_value self)
+{
+    mrb_bool status;
+    mrb_get_args(p_state, "b", &status);
+    cSprite* p_sprite = Get_Data_Ptr<cSprite>(p_state, self);
+    p_sprite->m_always_active = status;
+    p_sprite->m_always_active_set = true;
+
+    if (status)
+        p_sprite->m_sleeping = false;
+
+    return mrb_bool_value(status);
+}
+
+/**
+ * Method: Sprite#always_active?
+ *
+ *   always_active?() → true or false
+ *
+ * Checks if the sprite is never put to sleep far away from
+ * the camera. See also always_active=().
+ */
+static mrb_value Is_Always_Active(mrb_state* p_state, mrb_value self)
+{
+    cSprite* p_sprite = Get_Data_Ptr<cSprite>(p_state, self);
+    return mrb_bool_value(p_sprite->m_always_active);
+}
+
 void TSC::Scripting::Init_Sprite(mrb_state* p_state)
 {
     struct RClass* p_rcSprite = mrb_define_class(p_state, "Sprite", p_state->object_class);
@@ -671,6 +709,8 @@ void TSC::Scripting::Init_Sprite(mrb_state* p_state)
     mrb_define_method(p_state, p_rcSprite, "image=", Set_Image, MRB_ARGS_REQ(1));
     mrb_define_method(p_state, p_rcSprite, "active=", Set_Active, MRB_ARGS_REQ(1));
     mrb_define_method(p_state, p_rcSprite, "active?", Is_Active, MRB_ARGS_NONE());
+    mrb_define_method(p_state, p_rcSprite, "always_active=", Set_Always_Active, MRB_ARGS_REQ(1));
+    mrb_define_method(p_state, p_rcSprite, "always_active?", Is_Always_Active, MRB_ARGS_NONE());
 
     mrb_define_method(p_state, p_rcSprite, "on_touch", MRUBY_EVENT_HANDLER(touch), MRB_ARGS_NONE());
 }
@@ -123,6 +123,28 @@ std::vector<mrb_value>::iterator cScriptable_Object::event_handlers_end(const st
     return m_callbacks[get_active_level_name()][evtname].end();
 }
 
+/**
+ * Checks if any event handler is registered for any level.
+ * Objects with event handlers are controlled by scripts and
+ * therefore never put to sleep outside the camera region.
+ *
+ * \returns true if at least one callback is registered.
+ */
+bool cScriptable_Object::has_event_handlers() const
+{
+    std::map<std::string, std::map<std::string, std::vector<mrb_value> > >::const_iterator level_iter;
+    std::map<std::string, std::vector<mrb_value> >::const_iterator event_iter;
+
+    for (level_iter = m_callbacks.begin(); level_iter != m_callbacks.end(); level_iter++) {
+        for (event_iter = level_iter->second.begin(); event_iter != level_iter->second.end(); event_iter++) {
+            if (!event_iter->second.empty())
+                return true;
+        }
+    }
+
+    return false;
+}
+
 std::string cScriptable_Object::get_active_level_name()
 {
     return path_to_utf8(pActive_Level->m_level_filename.stem());
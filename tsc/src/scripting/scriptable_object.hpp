@@ -33,6 +33,8 @@ namespace TSC {
             void register_event_handler(const std::string& evtname, mrb_value callback);
             std::vector<mrb_value>::iterator event_handlers_begin(const std::string& evtname);
             std::vector<mrb_value>::iterator event_handlers_end(const std::string& evtname);
+            // Returns true if any event handler is registered
+            bool has_event_handlers() const;
 
         protected:
             /// Mapping of level + event names and registered callbacks.
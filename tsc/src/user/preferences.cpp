@@ -53,6 +53,11 @@ const uint8_t cPreferences::m_video_screen_bpp_default = 32;
 */
 const bool cPreferences::m_video_vsync_default = 0;
 const uint16_t cPreferences::m_video_fps_limit_default = 240;
+// the frame is shown one frame later
+const bool cPreferences::m_video_render_thread_default = 0;
+// the fixed function pipeline is used if not available
+const bool cPreferences::m_video_shaders_default = 1;
+const unsigned int cPreferences::m_video_particle_max_default = 4000;
 // default geometry detail is medium
 const float cPreferences::m_geometry_quality_default = 0.5f;
 // default texture detail is high
@@ -157,6 +162,9 @@ void cPreferences::Save(void)
     Add_Property(p_root, "video_screen_bpp", static_cast<int>(m_video_screen_bpp));
     Add_Property(p_root, "video_vsync", m_video_vsync);
     Add_Property(p_root, "video_fps_limit", m_video_fps_limit);
+    Add_Property(p_root, "video_render_thread", m_video_render_thread);
+    Add_Property(p_root, "video_shaders", m_video_shaders);
+    Add_Property(p_root, "video_particle_max", m_video_particle_max);
     Add_Property(p_root, "video_geometry_quality", pVideo->m_geometry_quality);
     Add_Property(p_root, "video_texture_quality", pVideo->m_texture_quality);
     // Audio
@@ -200,6 +208,7 @@ void cPreferences::Save(void)
     // Special
     Add_Property(p_root, "level_background_images", m_level_background_images);
     Add_Property(p_root, "image_cache_enabled", m_image_cache_enabled);
+    Add_Property(p_root, "swept_collision", m_swept_collision);
     // Editor
     Add_Property(p_root, "editor_mouse_auto_hide", m_editor_mouse_auto_hide);
     Add_Property(p_root, "editor_show_item_images", m_editor_show_item_images);
@@ -225,6 +234,7 @@ void cPreferences::Reset_All(void)
     // Special
     m_level_background_images = 1;
     m_image_cache_enabled = 1;
+    m_swept_collision = 0;
 }
 
 void cPreferences::Reset_Game(void)
@@ -244,6 +254,9 @@ void cPreferences::Reset_Video(void)
     m_video_screen_bpp = m_video_screen_bpp_default;
     m_video_vsync = m_video_vsync_default;
     m_video_fps_limit = m_video_fps_limit_default;
+    m_video_render_thread = m_video_render_thread_default;
+    m_video_shaders = m_video_shaders_default;
+    m_video_particle_max = m_video_particle_max_default;
     m_video_fullscreen = m_video_fullscreen_default;
     pVideo->m_geometry_quality = m_geometry_quality_default;
     pVideo->m_texture_quality = m_texture_quality_default;
@@ -85,6 +85,12 @@ namespace TSC {
         uint8_t m_video_screen_bpp;
         bool m_video_vsync;
         uint16_t m_video_fps_limit;
+        // render the game in its own thread
+        bool m_video_render_thread;
+        // use shaders if available
+        bool m_video_shaders;
+        // maximum of live particles before emitters are throttled, 0 for no limit
+        unsigned int m_video_particle_max;
 
         // Keyboard
         // key definitions
@@ -137,6 +143,10 @@ namespace TSC {
         bool m_level_background_images;
         // image cache enabled
         bool m_image_cache_enabled;
+        /* calculate collision movement directly instead of checking each step
+         * off by default, for comparing both paths
+        */
+        bool m_swept_collision;
 
         /* *** *** *** *** *** *** *** */
 
@@ -170,6 +180,9 @@ namespace TSC {
         static const uint8_t m_video_screen_bpp_default;
         static const bool m_video_vsync_default;
         static const uint16_t m_video_fps_limit_default;
+        static const bool m_video_render_thread_default;
+        static const bool m_video_shaders_default;
+        static const unsigned int m_video_particle_max_default;
         static const float m_geometry_quality_default;
         static const float m_texture_quality_default;
         // Keyboard
@@ -163,6 +163,12 @@ void cPreferencesLoader::handle_property(const std::string& name, const std::str
         mp_preferences->m_video_vsync = string_to_bool(value);
     else if (name == "video_fps_limit")
         mp_preferences->m_video_fps_limit = string_to_int(value);
+    else if (name == "video_render_thread")
+        mp_preferences->m_video_render_thread = string_to_bool(value);
+    else if (name == "video_shaders")
+        mp_preferences->m_video_shaders = string_to_bool(value);
+    else if (name == "video_particle_max")
+        mp_preferences->m_video_particle_max = string_to_int(value);
     else if (name == "video_fullscreen")
         mp_preferences->m_video_fullscreen = string_to_bool(value);
     else if (name == "video_geometry_detail" || name == "video_geometry_quality")
@@ -337,6 +343,8 @@ void cPreferencesLoader::handle_property(const std::string& name, const std::str
         mp_preferences->m_level_background_images = string_to_bool(value);
     else if (name == "image_cache_enabled")
         mp_preferences->m_image_cache_enabled = string_to_bool(value);
+    else if (name == "swept_collision")
+        mp_preferences->m_swept_collision = string_to_bool(value);
     //////////////////// Editor ////////////////////
     else if (name == "editor_mouse_auto_hide")
         mp_preferences->m_editor_mouse_auto_hide = string_to_bool(value);
@@ -19,6 +19,7 @@
 #include "../core/game_core.hpp"
 #include "../video/gl_surface.hpp"
 #include "../video/renderer.hpp"
+#include "../video/particle_kernel.hpp"
 #include "../core/math/utilities.hpp"
 #include "../core/i18n.hpp"
 #include "../core/filesystem/filesystem.hpp"
@@ -349,121 +350,134 @@ void cAnimation_Fireball::Draw(cSurface_Request* request /* = NULL */)
     }
 }
 
-/* *** *** *** *** *** *** *** cParticle *** *** *** *** *** *** *** *** *** *** */
-
-cParticle::cParticle(cParticle_Emitter* parent)
-    : cMovingSprite(parent->m_sprite_manager)
-{
-    m_can_be_on_ground = 0;
-    // scale centered
-    Set_Scale_Directions(1, 1, 1, 1);
-
-    m_time_to_live = 0.0f;
-    m_const_rot_x = 0.0f;
-    m_const_rot_y = 0.0f;
-    m_const_rot_z = 0.0f;
-    m_gravity_x = 0.0f;
-    m_gravity_y = 0.0f;
-
-    m_fade_pos = 1.0f;
-
-    m_parent = parent;
-}
-
-cParticle::~cParticle(void)
-{
-
-}
-
-void cParticle::Update(void)
-{
-    // update fade modifier
-    m_fade_pos -= ((static_cast<float>(speedfactor_fps) * 0.001f) * pFramerate->m_speed_factor) / m_time_to_live;
-
-    // finished fading
-    if (m_fade_pos <= 0.0f) {
-        m_fade_pos = 0.0f;
-        Set_Active(0);
-        return;
-    }
-
-    // with size fading
-    if (m_parent->m_fade_size) {
-        Set_Scale(m_start_scale_x * m_fade_pos);
-    }
-
-    // move
-    Move(m_velx, m_vely);
-    // todo : gravity maximum
-    Add_Velocity(m_gravity_x, m_gravity_y);
-
-    // constant rotation
-    if (!Is_Float_Equal(m_const_rot_x, 0.0f)) {
-        Add_Rotation_X(m_const_rot_x * pFramerate->m_speed_factor);
-    }
-    if (!Is_Float_Equal(m_const_rot_y, 0.0f)) {
-        Add_Rotation_Y(m_const_rot_y * pFramerate->m_speed_factor);
-    }
-    if (!Is_Float_Equal(m_const_rot_z, 0.0f)) {
-        Add_Rotation_Z(m_const_rot_z * pFramerate->m_speed_factor);
-    }
-}
-
-void cParticle::Draw(cSurface_Request* request /* = NULL */)
-{
-    if (!m_image) {
-        return;
-    }
-
-    bool create_request = 0;
-
-    if (!request) {
-        create_request = 1;
-        // create request
-        request = new cSurface_Request();
-    }
-
-    Draw_Image_Normal(request);
-
-    // based on emitter position
-    if (m_parent->m_particle_based_on_emitter_pos > 0.0f) {
-        request->m_pos_x += (m_parent->m_pos_x * m_parent->m_particle_based_on_emitter_pos);
-        request->m_pos_y += (m_parent->m_pos_y * m_parent->m_particle_based_on_emitter_pos);
-    }
-
-    // blending
-    if (m_parent->m_blending == BLEND_ADD) {
-        request->m_blend_sfactor = GL_SRC_ALPHA;
-        request->m_blend_dfactor = GL_ONE;
-    }
-    else if (m_parent->m_blending == BLEND_DRIVE) {
-        request->m_blend_sfactor = GL_SRC_COLOR;
-        request->m_blend_dfactor = GL_DST_ALPHA;
-    }
-
-    // color fading
-    if (m_parent->m_fade_color) {
-        request->m_color.red = static_cast<uint8_t>(m_color.red * m_fade_pos);
-        request->m_color.green = static_cast<uint8_t>(m_color.green * m_fade_pos);
-        request->m_color.blue = static_cast<uint8_t>(m_color.blue * m_fade_pos);
-    }
-
-    // alpha fading
-    if (m_parent->m_fade_alpha) {
-        request->m_color.alpha = static_cast<uint8_t>(request->m_color.alpha * m_fade_pos);
-    }
-
-    if (create_request) {
-        // add request
-        pRenderer->Add(request);
-    }
-}
-
-void cParticle::Set_Gravity(float x, float y)
-{
-    m_gravity_x = x;
-    m_gravity_y = y;
-}
+/* *** *** *** *** *** *** *** cParticle_Array *** *** *** *** *** *** *** *** *** *** */
+
+unsigned int cParticle_Array::Add(void)
+{
+    m_pos_x.push_back(0.0f);
+    m_pos_y.push_back(0.0f);
+    m_pos_z.push_back(0.0f);
+    m_vel_x.push_back(0.0f);
+    m_vel_y.push_back(0.0f);
+    m_gravity_x.push_back(0.0f);
+    m_gravity_y.push_back(0.0f);
+    m_rot_x.push_back(0.0f);
+    m_rot_y.push_back(0.0f);
+    m_rot_z.push_back(0.0f);
+    m_const_rot_x.push_back(0.0f);
+    m_const_rot_y.push_back(0.0f);
+    m_const_rot_z.push_back(0.0f);
+    m_scale.push_back(1.0f);
+    m_start_scale.push_back(1.0f);
+    m_color.push_back(white);
+    m_fade_pos.push_back(1.0f);
+    m_time_to_live.push_back(0.0f);
+
+    return m_fade_pos.size() - 1;
+}
+
+void cParticle_Array::Remove(unsigned int index)
+{
+    const unsigned int last = m_fade_pos.size() - 1;
+
+    if (index != last) {
+        m_pos_x[index] = m_pos_x[last];
+        m_pos_y[index] = m_pos_y[last];
+        m_pos_z[index] = m_pos_z[last];
+        m_vel_x[index] = m_vel_x[last];
+        m_vel_y[index] = m_vel_y[last];
+        m_gravity_x[index] = m_gravity_x[last];
+        m_gravity_y[index] = m_gravity_y[last];
+        m_rot_x[index] = m_rot_x[last];
+        m_rot_y[index] = m_rot_y[last];
+        m_rot_z[index] = m_rot_z[last];
+        m_const_rot_x[index] = m_const_rot_x[last];
+        m_const_rot_y[index] = m_const_rot_y[last];
+        m_const_rot_z[index] = m_const_rot_z[last];
+        m_scale[index] = m_scale[last];
+        m_start_scale[index] = m_start_scale[last];
+        m_color[index] = m_color[last];
+        m_fade_pos[index] = m_fade_pos[last];
+        m_time_to_live[index] = m_time_to_live[last];
+    }
+
+    m_pos_x.pop_back();
+    m_pos_y.pop_back();
+    m_pos_z.pop_back();
+    m_vel_x.pop_back();
+    m_vel_y.pop_back();
+    m_gravity_x.pop_back();
+    m_gravity_y.pop_back();
+    m_rot_x.pop_back();
+    m_rot_y.pop_back();
+    m_rot_z.pop_back();
+    m_const_rot_x.pop_back();
+    m_const_rot_y.pop_back();
+    m_const_rot_z.pop_back();
+    m_scale.pop_back();
+    m_start_scale.pop_back();
+    m_color.pop_back();
+    m_fade_pos.pop_back();
+    m_time_to_live.pop_back();
+}
+
+void cParticle_Array::Clear(void)
+{
+    // keeps the capacity for the next particles
+    m_pos_x.clear();
+    m_pos_y.clear();
+    m_pos_z.clear();
+    m_vel_x.clear();
+    m_vel_y.clear();
+    m_gravity_x.clear();
+    m_gravity_y.clear();
+    m_rot_x.clear();
+    m_rot_y.clear();
+    m_rot_z.clear();
+    m_const_rot_x.clear();
+    m_const_rot_y.clear();
+    m_const_rot_z.clear();
+    m_scale.clear();
+    m_start_scale.clear();
+    m_color.clear();
+    m_fade_pos.clear();
+    m_time_to_live.clear();
+}
+
+Particle_Kernel_Arrays cParticle_Array::Get_Kernel_Arrays(void)
+{
+    Particle_Kernel_Arrays arrays;
+    arrays.m_pos_x = m_pos_x.data();
+    arrays.m_pos_y = m_pos_y.data();
+    arrays.m_vel_x = m_vel_x.data();
+    arrays.m_vel_y = m_vel_y.data();
+    arrays.m_gravity_x = m_gravity_x.data();
+    arrays.m_gravity_y = m_gravity_y.data();
+    arrays.m_scale = m_scale.data();
+    arrays.m_start_scale = m_start_scale.data();
+    arrays.m_fade_pos = m_fade_pos.data();
+    arrays.m_time_to_live = m_time_to_live.data();
+    arrays.m_count = Size();
+
+    return arrays;
+}
+
+// random values used per emitted particle
+enum ParticleRandomValue {
+    PARTICLE_RANDOM_POS_X,
+    PARTICLE_RANDOM_POS_Y,
+    PARTICLE_RANDOM_POS_Z,
+    PARTICLE_RANDOM_DIRECTION,
+    PARTICLE_RANDOM_SPEED,
+    PARTICLE_RANDOM_CONST_ROT_X,
+    PARTICLE_RANDOM_CONST_ROT_Y,
+    PARTICLE_RANDOM_CONST_ROT_Z,
+    PARTICLE_RANDOM_SCALE,
+    PARTICLE_RANDOM_GRAVITY_X,
+    PARTICLE_RANDOM_GRAVITY_Y,
+    PARTICLE_RANDOM_TIME_TO_LIVE,
+    PARTICLE_RANDOM_COUNT
+};
 
 /* *** *** *** *** *** *** *** cParticle_Emitter *** *** *** *** *** *** *** *** *** *** */
 
@@ -471,6 +485,10 @@ cParticle_Emitter::cParticle_Emitter(cSprite_Manager* sprite_manager)
     : cAnimation(sprite_manager, "particle_emitter")
 {
     cParticle_Emitter::Init();
+
+    if (pParticle_Budget) {
+        pParticle_Budget->Register(this);
+    }
 }
 
 cParticle_Emitter::cParticle_Emitter(XmlAttributes& attributes, cSprite_Manager* sprite_manager)
@@ -478,6 +496,10 @@ cParticle_Emitter::cParticle_Emitter(XmlAttributes& attributes, cSprite_Manager*
 {
     cParticle_Emitter::Init();
 
+    if (pParticle_Budget) {
+        pParticle_Budget->Register(this);
+    }
+
     // Particle image filename
     Set_Image_Filename(utf8_to_path(attributes["particle_image"]));
 
@@ -564,6 +586,10 @@ cParticle_Emitter::cParticle_Emitter(XmlAttributes& attributes, cSprite_Manager*
 cParticle_Emitter::~cParticle_Emitter(void)
 {
     cParticle_Emitter::Clear();
+
+    if (pParticle_Budget) {
+        pParticle_Budget->Unregister(this);
+    }
 }
 
 void cParticle_Emitter::Init(void)
@@ -627,6 +653,9 @@ void cParticle_Emitter::Init(void)
     // animation data
     m_emit_counter = 0.0f;
     m_emitter_living_time = 0.0f;
+
+    // different for every emitter unless seeded
+    m_random.Seed(game_random.Get_Uint32());
 }
 
 cParticle_Emitter* cParticle_Emitter::Copy(void) const
@@ -766,122 +795,134 @@ void cParticle_Emitter::Emit(void)
         return;
     }
 
-    for (unsigned int i = 0; i < m_emitter_quota; i++) {
-        cParticle* particle = new cParticle(this);
+    // less particles if over the budget
+    unsigned int quota = m_emitter_quota;
+    if (quota > 1) {
+        quota = max(static_cast<unsigned int>(quota * pParticle_Budget->Get_Emit_Factor(Get_Particle_Priority()) + 0.5f), 1u);
+    }
+
+    // all random values of this emit at once
+    m_random_values.resize(quota * PARTICLE_RANDOM_COUNT);
+    m_random.Get_Floats(m_random_values.data(), m_random_values.size());
+
+    for (unsigned int i = 0; i < quota; i++) {
+        const unsigned int index = m_particles.Add();
+        // random values from 0 to 1 for this particle
+        const float* random = &m_random_values[i * PARTICLE_RANDOM_COUNT];
 
         // X Position
         float x = m_pos_x - (m_image->m_w * 0.5f);
         if (m_rect.m_w > 0.0f) {
-            x += Get_Random_Float(0.0f, m_rect.m_w);
+            x += m_rect.m_w * random[PARTICLE_RANDOM_POS_X];
         }
         // Y Position
         float y = m_pos_y - (m_image->m_h * 0.5f);
         if (m_rect.m_h > 0.0f) {
-            y += Get_Random_Float(0.0f, m_rect.m_h);
+            y += m_rect.m_h * random[PARTICLE_RANDOM_POS_Y];
         }
         // Set Position
-        particle->Set_Pos(x, y, 1);
-
-        // Image
-        particle->Set_Image(m_image, 1);
+        m_particles.m_pos_x[index] = x;
+        m_particles.m_pos_y[index] = y;
 
         // Z position
-        particle->m_pos_z = m_pos_z;
+        m_particles.m_pos_z[index] = m_pos_z;
         if (m_pos_z_rand > 0.0f) {
-            particle->m_pos_z += Get_Random_Float(0.0f, m_pos_z_rand);
+            m_particles.m_pos_z[index] += m_pos_z_rand * random[PARTICLE_RANDOM_POS_Z];
         }
 
         // angle range
         float dir_angle = m_angle_start;
         // start angle
         if (m_angle_range > 0.0f) {
-            dir_angle += Get_Random_Float(0.0f, m_angle_range);
+            dir_angle += m_angle_range * random[PARTICLE_RANDOM_DIRECTION];
         }
 
         // Velocity
         float speed = m_vel;
         if (m_vel_rand > 0.0f) {
-            speed += Get_Random_Float(0.0f, m_vel_rand);
+            speed += m_vel_rand * random[PARTICLE_RANDOM_SPEED];
         }
         // Set Velocity
-        particle->Set_Velocity_From_Angle(dir_angle, speed, 1);
+        m_particles.m_vel_x[index] = cos(dir_angle * deg_to_rad) * speed;
+        m_particles.m_vel_y[index] = sin(dir_angle * deg_to_rad) * speed;
 
         // Start rotation
-        particle->m_rot_x = m_start_rot_x;
-        particle->m_rot_y = m_start_rot_y;
-        particle->m_rot_z = m_start_rot_z;
+        m_particles.m_rot_x[index] = m_start_rot_x;
+        m_particles.m_rot_y[index] = m_start_rot_y;
+        m_particles.m_rot_z[index] = m_start_rot_z;
 
         // Start direction is added to the z rotation
         if (m_start_rot_z_uses_direction) {
-            particle->m_rot_z += dir_angle;
+            m_particles.m_rot_z[index] += dir_angle;
         }
 
         // Constant rotation
-        particle->m_const_rot_x = m_const_rot_x;
-        particle->m_const_rot_y = m_const_rot_y;
-        particle->m_const_rot_z = m_const_rot_z;
+        m_particles.m_const_rot_x[index] = m_const_rot_x;
+        m_particles.m_const_rot_y[index] = m_const_rot_y;
+        m_particles.m_const_rot_z[index] = m_const_rot_z;
         if (m_const_rot_x_rand > 0.0f) {
-            particle->m_const_rot_x += Get_Random_Float(0.0f, m_const_rot_x_rand);
+            m_particles.m_const_rot_x[index] += m_const_rot_x_rand * random[PARTICLE_RANDOM_CONST_ROT_X];
         }
         if (m_const_rot_y_rand > 0.0f) {
-            particle->m_const_rot_y += Get_Random_Float(0.0f, m_const_rot_y_rand);
+            m_particles.m_const_rot_y[index] += m_const_rot_y_rand * random[PARTICLE_RANDOM_CONST_ROT_Y];
         }
         if (m_const_rot_z_rand > 0.0f) {
-            particle->m_const_rot_z += Get_Random_Float(0.0f, m_const_rot_z_rand);
+            m_particles.m_const_rot_z[index] += m_const_rot_z_rand * random[PARTICLE_RANDOM_CONST_ROT_Z];
         }
 
         // Scale
         float scale = m_size_scale;
         if (m_size_scale_rand > 0.0f) {
-            scale += Get_Random_Float(0.0f, m_size_scale_rand);
+            scale += m_size_scale_rand * random[PARTICLE_RANDOM_SCALE];
+        }
+        // invalid value
+        if (Is_Float_Equal(scale, 0.0f)) {
+            scale = 1.0f;
         }
-        particle->Set_Scale(scale, 1);
+        m_particles.m_scale[index] = scale;
+        m_particles.m_start_scale[index] = scale;
 
         // Gravity
         float grav_x = m_gravity_x;
         if (m_gravity_x_rand > 0.0f) {
-            grav_x += Get_Random_Float(0.0f, m_gravity_x_rand);
+            grav_x += m_gravity_x_rand * random[PARTICLE_RANDOM_GRAVITY_X];
         }
         float grav_y = m_gravity_y;
         if (m_gravity_y_rand > 0.0f) {
-            grav_y += Get_Random_Float(0.0f, m_gravity_y_rand);
+            grav_y += m_gravity_y_rand * random[PARTICLE_RANDOM_GRAVITY_Y];
         }
         // set Gravity
-        particle->Set_Gravity(grav_x, grav_y);
+        m_particles.m_gravity_x[index] = grav_x;
+        m_particles.m_gravity_y[index] = grav_y;
 
         // Color
-        particle->Set_Color(m_color);
+        Color& color = m_particles.m_color[index];
+        color = m_color;
         if (m_color_rand.red > 0) {
-            particle->m_color.red += rand() % m_color_rand.red;
+            color.red += m_random.Get_Uint32(m_color_rand.red);
         }
         if (m_color_rand.green > 0) {
-            particle->m_color.green += rand() % m_color_rand.green;
+            color.green += m_random.Get_Uint32(m_color_rand.green);
         }
         if (m_color_rand.blue > 0) {
-            particle->m_color.blue += rand() % m_color_rand.blue;
+            color.blue += m_random.Get_Uint32(m_color_rand.blue);
         }
         if (m_color_rand.alpha > 0) {
-            particle->m_color.alpha += rand() % m_color_rand.alpha;
+            color.alpha += m_random.Get_Uint32(m_color_rand.alpha);
         }
 
         // Time to life
-        particle->m_time_to_live = m_time_to_live;
+        m_particles.m_time_to_live[index] = m_time_to_live;
         if (m_time_to_live_rand > 0.0f) {
-            particle->m_time_to_live += Get_Random_Float(0.0f, m_time_to_live_rand);
+            m_particles.m_time_to_live[index] += m_time_to_live_rand * random[PARTICLE_RANDOM_TIME_TO_LIVE];
         }
-
-        m_objects.push_back(particle);
     }
 }
 
 void cParticle_Emitter::Clear(bool reset /* = 1 */)
 {
     // clear particles
-    for (ParticleList::iterator itr = m_objects.begin(); itr != m_objects.end(); ++itr) {
-        delete *itr;
-    }
-
-    m_objects.clear();
+    m_particles.Clear();
 
     // clear animation data
     m_emit_counter = 0.0f;
@@ -904,41 +945,68 @@ void cParticle_Emitter::Update(void)
     m_emitter_living_time += pFramerate->m_speed_factor * (static_cast<float>(speedfactor_fps) * 0.001f);
 
     Update_Particles();
+
+    pParticle_Budget->Add_Live_Particles(Get_Particle_Priority(), m_particles.Size());
 }
 
 void cParticle_Emitter::Update_Particles(void)
 {
-    // update objects
-    for (ParticleList::iterator itr = m_objects.begin(); itr != m_objects.end();) {
-        // get object pointer
-        cParticle* obj = (*itr);
+    const unsigned int count = m_particles.Size();
+    const float speed_factor = pFramerate->m_speed_factor;
+    const float fade_speed = (static_cast<float>(speedfactor_fps) * 0.001f) * speed_factor;
+    const Particle_Kernel_Arrays arrays = m_particles.Get_Kernel_Arrays();
 
-        // update
-        obj->Update();
+    // fade and move
+    Particle_Kernel_Integrate(arrays, fade_speed, speed_factor);
 
-        // if finished
-        if (!obj->m_active) {
-            itr = m_objects.erase(itr);
-            delete obj;
+    // with size fading
+    if (m_fade_size) {
+        Particle_Kernel_Fade_Size(arrays);
+    }
+
+    // constant rotation only if any particle can have it
+    if (!Is_Float_Equal(m_const_rot_x, 0.0f) || m_const_rot_x_rand > 0.0f) {
+        Particle_Kernel_Rotate(m_particles.m_rot_x.data(), m_particles.m_const_rot_x.data(), count, speed_factor);
+    }
+    if (!Is_Float_Equal(m_const_rot_y, 0.0f) || m_const_rot_y_rand > 0.0f) {
+        Particle_Kernel_Rotate(m_particles.m_rot_y.data(), m_particles.m_const_rot_y.data(), count, speed_factor);
+    }
+    if (!Is_Float_Equal(m_const_rot_z, 0.0f) || m_const_rot_z_rand > 0.0f) {
+        Particle_Kernel_Rotate(m_particles.m_rot_z.data(), m_particles.m_const_rot_z.data(), count, speed_factor);
+    }
+
+    // remove finished particles
+    for (unsigned int i = 0; i < m_particles.Size();) {
+        if (m_particles.m_fade_pos[i] <= 0.0f) {
+            m_particles.Remove(i);
         }
-        // increment
         else {
-            ++itr;
+            i++;
         }
     }
 
     // if able to emit or endless emitter
     if (m_emitter_living_time < m_emitter_time_to_live || Is_Float_Equal(m_emitter_time_to_live, -1.0f)) {
+        const ParticlePriority priority = Get_Particle_Priority();
+        // longer interval if over the budget
+        const float interval = m_emitter_iteration_interval / pParticle_Budget->Get_Emit_Factor(priority);
+
+        // no new particles until below the maximum
+        if (pParticle_Budget->Is_Full(priority)) {
+            m_emit_counter = min(m_emit_counter, interval);
+        }
         // emit
-        while (m_emit_counter > m_emitter_iteration_interval) {
-            Emit();
-            m_emit_counter -= m_emitter_iteration_interval;
+        else {
+            while (m_emit_counter > interval) {
+                Emit();
+                m_emit_counter -= interval;
+            }
         }
 
         m_emit_counter += pFramerate->m_speed_factor * (static_cast<float>(speedfactor_fps) * 0.001f);
     }
     // no particles are active
-    else if (m_objects.empty()) {
+    else if (m_particles.Empty()) {
         Set_Active(0);
     }
 }
@@ -981,9 +1049,7 @@ void cParticle_Emitter::Draw(cSurface_Request* request /* = NULL */)
         return;
     }
 
-    for (ParticleList::iterator itr = m_objects.begin(); itr != m_objects.end(); ++itr) {
-        (*itr)->Draw();
-    }
+    Draw_Particles();
 
     if (editor_enabled) {
         if (!m_spawned) {
@@ -1012,95 +1078,220 @@ void cParticle_Emitter::Draw(cSurface_Request* request /* = NULL */)
     }
 }
 
+void cParticle_Emitter::Draw_Particles(void)
+{
+    if (!m_image || m_particles.Empty()) {
+        return;
+    }
+
+    const unsigned int count = m_particles.Size();
+
+    // the same for all particles
+    float offset_x = m_image->m_int_x;
+    float offset_y = m_image->m_int_y;
+
+    // based on emitter position
+    if (m_particle_based_on_emitter_pos > 0.0f) {
+        offset_x += m_pos_x * m_particle_based_on_emitter_pos;
+        offset_y += m_pos_y * m_particle_based_on_emitter_pos;
+    }
+
+    GLenum blend_sfactor = GL_SRC_ALPHA;
+    GLenum blend_dfactor = GL_ONE_MINUS_SRC_ALPHA;
+
+    // blending
+    if (m_blending == BLEND_ADD) {
+        blend_sfactor = GL_SRC_ALPHA;
+        blend_dfactor = GL_ONE;
+    }
+    else if (m_blending == BLEND_DRIVE) {
+        blend_sfactor = GL_SRC_COLOR;
+        blend_dfactor = GL_DST_ALPHA;
+    }
+
+    // all particles as one request drawn with a single call
+    cParticle_Request* request = new cParticle_Request();
+
+    // texture id
+    request->m_texture_id = m_image->m_image;
+    // texture coordinates
+    request->m_tex_left = m_image->m_tex_left;
+    request->m_tex_top = m_image->m_tex_top;
+    request->m_tex_right = m_image->m_tex_right;
+    request->m_tex_bottom = m_image->m_tex_bottom;
+
+    // size
+    request->m_w = m_image->m_start_w;
+    request->m_h = m_image->m_start_h;
+
+    request->m_blend_sfactor = blend_sfactor;
+    request->m_blend_dfactor = blend_dfactor;
+
+    request->m_instances.reserve(count);
+    // the highest particle of the z range
+    request->m_pos_z = m_pos_z;
+
+    for (unsigned int i = 0; i < count; i++) {
+        const float scale = m_particles.m_scale[i];
+        const float fade_pos = m_particles.m_fade_pos[i];
+
+        Particle_Instance& instance = request->Add_Instance();
+
+        // rotation
+        instance.m_rot_x = m_particles.m_rot_x[i] + m_image->m_base_rot_x;
+        instance.m_rot_y = m_particles.m_rot_y[i] + m_image->m_base_rot_y;
+        instance.m_rot_z = m_particles.m_rot_z[i] + m_image->m_base_rot_z;
+
+        // position
+        instance.m_pos_x = m_particles.m_pos_x[i] + offset_x;
+        instance.m_pos_y = m_particles.m_pos_y[i] + offset_y;
+        instance.m_pos_z = m_particles.m_pos_z[i];
+        instance.m_scale = scale;
+
+        // scaled centered
+        if (scale != 1.0f) {
+            instance.m_pos_x += (m_image->m_int_x * (scale - 1.0f)) - ((m_image->m_w * 0.5f) * (scale - 1.0f));
+            instance.m_pos_y += (m_image->m_int_y * (scale - 1.0f)) - ((m_image->m_h * 0.5f) * (scale - 1.0f));
+        }
+
+        if (instance.m_pos_z > request->m_pos_z) {
+            request->m_pos_z = instance.m_pos_z;
+        }
+
+        // color
+        instance.m_color = m_particles.m_color[i];
+
+        // color fading
+        if (m_fade_color) {
+            instance.m_color.red = static_cast<uint8_t>(instance.m_color.red * fade_pos);
+            instance.m_color.green = static_cast<uint8_t>(instance.m_color.green * fade_pos);
+            instance.m_color.blue = static_cast<uint8_t>(instance.m_color.blue * fade_pos);
+        }
+
+        // alpha fading
+        if (m_fade_alpha) {
+            instance.m_color.alpha = static_cast<uint8_t>(instance.m_color.alpha * fade_pos);
+        }
+    }
+
+    // back to front inside the z range
+    if (m_pos_z_rand > 0.0f) {
+        request->Sort_Instances();
+    }
+
+    // add request
+    pRenderer->Add(request);
+}
+
+ParticlePriority cParticle_Emitter::Get_Particle_Priority(void) const
+{
+    if (!m_spawned || m_emitter_based_on_camera_pos) {
+        return PARTICLE_PRIORITY_AMBIENCE;
+    }
+
+    return PARTICLE_PRIORITY_GAMEPLAY;
+}
+
 void cParticle_Emitter::Keep_Particles_In_Rect(const GL_rect& clip_rect, ParticleClipMode mode /* = PCM_MOVE */)
 {
+    if (!m_image) {
+        return;
+    }
+
     // temporary obj rect
     GL_rect obj_rect;
 
     // find particles that are not visible and move them to the opposite screen side
-    for (ParticleList::iterator itr = m_objects.begin(); itr != m_objects.end(); ++itr) {
-        // get animation particle pointer
-        cParticle* obj = static_cast<cParticle*>(*itr);
+    for (unsigned int i = 0; i < m_particles.Size();) {
+        float& pos_x = m_particles.m_pos_x[i];
+        float& pos_y = m_particles.m_pos_y[i];
+        float& vel_x = m_particles.m_vel_x[i];
+        float& vel_y = m_particles.m_vel_y[i];
+        const float scale = m_particles.m_scale[i];
 
         // set rectangle
-        if (obj->m_scale_x != 1.0f) {
-            obj_rect.m_x = obj->m_pos_x - ((obj->m_image->m_w * 0.5f) * (obj->m_scale_x - 1.0f));
-            obj_rect.m_w = obj->m_rect.m_w * obj->m_scale_x;
+        if (scale != 1.0f) {
+            obj_rect.m_x = pos_x - ((m_image->m_w * 0.5f) * (scale - 1.0f));
+            obj_rect.m_y = pos_y - ((m_image->m_h * 0.5f) * (scale - 1.0f));
+            obj_rect.m_w = m_image->m_w * scale;
+            obj_rect.m_h = m_image->m_h * scale;
         }
         else {
-            obj_rect.m_x = obj->m_pos_x;
-            obj_rect.m_w = obj->m_rect.m_w;
+            obj_rect.m_x = pos_x;
+            obj_rect.m_y = pos_y;
+            obj_rect.m_w = m_image->m_w;
+            obj_rect.m_h = m_image->m_h;
         }
 
-        if (obj->m_scale_y != 1.0f) {
-            obj_rect.m_y = obj->m_pos_y - ((obj->m_image->m_h * 0.5f) * (obj->m_scale_y - 1.0f));
-            obj_rect.m_h = obj->m_rect.m_h * obj->m_scale_y;
-        }
-        else {
-            obj_rect.m_y = obj->m_pos_y;
-            obj_rect.m_h = obj->m_rect.m_h;
-        }
+        bool remove = 0;
 
         // out in left
         if (obj_rect.m_x + obj_rect.m_w < clip_rect.m_x) {
             // move to right
             if (mode == PCM_MOVE) {
-                obj->Move(clip_rect.m_w + obj_rect.m_w - 1.0f, 0, 1);
+                pos_x += clip_rect.m_w + obj_rect.m_w - 1.0f;
             }
             else if (mode == PCM_REVERSE) {
-                if (obj->m_velx < 0.0f) {
-                    obj->Set_Velocity(-obj->m_velx, obj->m_vely);
+                if (vel_x < 0.0f) {
+                    vel_x = -vel_x;
                 }
             }
             else if (mode == PCM_DELETE) {
-                obj->Set_Active(0);
+                remove = 1;
             }
         }
         // out in right
         else if (obj_rect.m_x > clip_rect.m_x + clip_rect.m_w) {
             // move to left
             if (mode == PCM_MOVE) {
-                obj->Move(-clip_rect.m_w - obj_rect.m_w + 1.0f, 0, 1);
+                pos_x += -clip_rect.m_w - obj_rect.m_w + 1.0f;
             }
             else if (mode == PCM_REVERSE) {
-                if (obj->m_velx > 0.0f) {
-                    obj->Set_Velocity(-obj->m_velx, obj->m_vely);
+                if (vel_x > 0.0f) {
+                    vel_x = -vel_x;
                 }
             }
             else if (mode == PCM_DELETE) {
-                obj->Set_Active(0);
+                remove = 1;
             }
         }
         // out on top
         else if (obj_rect.m_y + obj_rect.m_h < clip_rect.m_y) {
             // move to bottom
             if (mode == PCM_MOVE) {
-                obj->Move(0, clip_rect.m_h + obj_rect.m_h - 1.0f, 1);
+                pos_y += clip_rect.m_h + obj_rect.m_h - 1.0f;
             }
             else if (mode == PCM_REVERSE) {
-                if (obj->m_vely < 0.0f) {
-                    obj->Set_Velocity(obj->m_velx, -obj->m_vely);
+                if (vel_y < 0.0f) {
+                    vel_y = -vel_y;
                 }
             }
             else if (mode == PCM_DELETE) {
-                obj->Set_Active(0);
+                remove = 1;
             }
         }
         // out on bottom
         else if (obj_rect.m_y > clip_rect.m_y + clip_rect.m_h) {
             // move to top
             if (mode == PCM_MOVE) {
-                obj->Move(0, -clip_rect.m_h - obj_rect.m_h + 1.0f, 1);
+                pos_y += -clip_rect.m_h - obj_rect.m_h + 1.0f;
             }
             else if (mode == PCM_REVERSE) {
-                if (obj->m_vely > 0.0f) {
-                    obj->Set_Velocity(obj->m_velx, -obj->m_vely);
+                if (vel_y > 0.0f) {
+                    vel_y = -vel_y;
                 }
             }
             else if (mode == PCM_DELETE) {
-                obj->Set_Active(0);
+                remove = 1;
             }
         }
+
+        if (remove) {
+            m_particles.Remove(i);
+        }
+        else {
+            i++;
+        }
     }
 }
 
@@ -1216,6 +1407,8 @@ void cParticle_Emitter::Set_Emitter_Rect(float x, float y, float w /* = 0 */, fl
     m_col_rect.m_h = m_rect.m_h;
     m_start_rect.m_w = m_rect.m_w;
     m_start_rect.m_h = m_rect.m_h;
+
+    Update_Spatial_Hash();
 }
 
 void cParticle_Emitter::Set_Emitter_Rect(const GL_rect& rect)
@@ -1362,6 +1555,11 @@ void cParticle_Emitter::Set_Clip_Rect(const GL_rect& rect)
     }
 }
 
+void cParticle_Emitter::Set_Random_Seed(uint64_t seed, uint64_t stream /* = 0 */)
+{
+    m_random.Seed(seed, stream);
+}
+
 void cParticle_Emitter::Set_Clip_Mode(ParticleClipMode mode)
 {
     m_clip_mode = mode;
@@ -19,6 +19,9 @@
 
 #include "../objects/movingsprite.hpp"
 #include "../core/obj_manager.hpp"
+#include "../video/particle_budget.hpp"
+#include "../video/particle_kernel.hpp"
+#include "../core/math/random.hpp"
 
 namespace TSC {
 
@@ -118,37 +121,57 @@ namespace TSC {
 
     /* *** *** *** *** *** *** *** Particle Emitter item *** *** *** *** *** *** *** *** *** *** */
 
-// forward declare
-    class cParticle_Emitter;
-
-// Particle Item
-    class cParticle : public cMovingSprite {
+/* Particles of an emitter stored as packed arrays
+ * the same index in every array is one particle
+ * and removing a particle moves the last one into its place
+*/
+    class cParticle_Array {
     public:
-        cParticle(cParticle_Emitter* parent);
-        virtual ~cParticle(void);
-
-        // update
-        virtual void Update(void);
-        // draw
-        virtual void Draw(cSurface_Request* request = NULL);
-
-        // set gravity
-        void Set_Gravity(float x, float y);
-
-        // parent particle emitter
-        cParticle_Emitter* m_parent;
-        // time to live
-        float m_time_to_live;
+        // Return the particle count
+        inline unsigned int Size(void) const
+        {
+            return m_fade_pos.size();
+        };
+        inline bool Empty(void) const
+        {
+            return m_fade_pos.empty();
+        };
+
+        // Append a particle with default values and return its index
+        unsigned int Add(void);
+        // Remove the particle
+        void Remove(unsigned int index);
+        // Remove all particles
+        void Clear(void);
+        // Return the arrays for the particle kernel
+        Particle_Kernel_Arrays Get_Kernel_Arrays(void);
+
+        // position
+        vector<float> m_pos_x;
+        vector<float> m_pos_y;
+        vector<float> m_pos_z;
+        // velocity
+        vector<float> m_vel_x;
+        vector<float> m_vel_y;
+        // gravity
+        vector<float> m_gravity_x;
+        vector<float> m_gravity_y;
+        // rotation
+        vector<float> m_rot_x;
+        vector<float> m_rot_y;
+        vector<float> m_rot_z;
         // constant rotation
-        float m_const_rot_x;
-        float m_const_rot_y;
-        float m_const_rot_z;
-        // particle gravity
-        float m_gravity_x;
-        float m_gravity_y;
-
+        vector<float> m_const_rot_x;
+        vector<float> m_const_rot_y;
+        vector<float> m_const_rot_z;
+        // scale in both directions
+        vector<float> m_scale;
+        vector<float> m_start_scale;
+        vector<Color> m_color;
         // fading position value
-        float m_fade_pos;
+        vector<float> m_fade_pos;
+        // time to live
+        vector<float> m_time_to_live;
     };
 
     /* *** *** *** *** *** *** *** Particle Emitter *** *** *** *** *** *** *** *** *** *** */
@@ -199,6 +222,11 @@ namespace TSC {
         // Draw everything
         virtual void Draw(cSurface_Request* request = NULL);
 
+        /* Return the priority for the particle budget
+         * level emitters and emitters based on the camera position are ambience
+        */
+        ParticlePriority Get_Particle_Priority(void) const;
+
         // keep particles in the given rectangle
         void Keep_Particles_In_Rect(const GL_rect& clip_rect, ParticleClipMode mode = PCM_MOVE);
 
@@ -267,6 +295,10 @@ namespace TSC {
         void Set_Clip_Rect(const GL_rect& rect);
         // set the clip mode
         void Set_Clip_Mode(ParticleClipMode mode);
+        /* Restart the random values of the particles with the given seed
+         * emitters with the same seed and stream emit the same particles
+        */
+        void Set_Random_Seed(uint64_t seed, uint64_t stream = 0);
 
 #ifdef ENABLE_EDITOR
         // editor todo : start rotation x/y/z rand, color, color_rand
@@ -313,8 +345,7 @@ namespace TSC {
 #endif
 
         // Particle items
-        typedef vector<cParticle*> ParticleList;
-        ParticleList m_objects;
+        cParticle_Array m_particles;
 
         // filename of the particle image
         boost::filesystem::path m_image_filename;
@@ -374,10 +405,17 @@ namespace TSC {
         virtual std::string Get_XML_Type_Name();
 
     private:
+        // Add one cParticle_Request drawing all particles in a single call
+        void Draw_Particles(void);
+
         // time alive
         float m_emitter_living_time;
         // emit counter
         float m_emit_counter;
+        // random values of the particles
+        cRandom_Generator m_random;
+        // random values of the current emit
+        vector<float> m_random_values;
     };
 
     /* *** *** *** *** *** *** *** Animation Manager *** *** *** *** *** *** *** *** *** *** */
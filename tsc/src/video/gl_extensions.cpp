@@ -0,0 +1,169 @@
+/***************************************************************************
+ * gl_extensions.cpp - OpenGL functions above version 1.1
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/gl_extensions.hpp"
+
+#ifdef __APPLE__
+#include <dlfcn.h>
+#endif
+
+using namespace std;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** cGL_Extensions *** *** *** *** *** *** *** *** *** *** *** */
+
+cGL_Extensions::cGL_Extensions(void)
+{
+    glGenBuffers = NULL;
+    glDeleteBuffers = NULL;
+    glBindBuffer = NULL;
+    glBufferData = NULL;
+
+    glCreateShader = NULL;
+    glDeleteShader = NULL;
+    glShaderSource = NULL;
+    glCompileShader = NULL;
+    glGetShaderiv = NULL;
+    glGetShaderInfoLog = NULL;
+    glCreateProgram = NULL;
+    glDeleteProgram = NULL;
+    glAttachShader = NULL;
+    glBindAttribLocation = NULL;
+    glLinkProgram = NULL;
+    glGetProgramiv = NULL;
+    glGetProgramInfoLog = NULL;
+    glUseProgram = NULL;
+    glGetUniformLocation = NULL;
+    glUniform1i = NULL;
+    glEnableVertexAttribArray = NULL;
+    glDisableVertexAttribArray = NULL;
+    glVertexAttribPointer = NULL;
+
+    m_context_num = 0;
+    m_vertex_buffers = 0;
+    m_shaders = 0;
+}
+
+cGL_Extensions::~cGL_Extensions(void)
+{
+
+}
+
+void cGL_Extensions::Init(void)
+{
+    m_context_num++;
+    m_vertex_buffers = 0;
+
+    const char* version_str = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    const char* extensions_str = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    int major = 0;
+    int minor = 0;
+
+    if (version_str) {
+        sscanf(version_str, "%d.%d", &major, &minor);
+    }
+
+    // core since 1.5
+    if (major > 1 || (major == 1 && minor >= 5)) {
+        glGenBuffers = reinterpret_cast<Gen_Buffers_Func>(Get_Function("glGenBuffers"));
+        glDeleteBuffers = reinterpret_cast<Delete_Buffers_Func>(Get_Function("glDeleteBuffers"));
+        glBindBuffer = reinterpret_cast<Bind_Buffer_Func>(Get_Function("glBindBuffer"));
+        glBufferData = reinterpret_cast<Buffer_Data_Func>(Get_Function("glBufferData"));
+    }
+    // extension
+    else if (extensions_str && strstr(extensions_str, "GL_ARB_vertex_buffer_object")) {
+        glGenBuffers = reinterpret_cast<Gen_Buffers_Func>(Get_Function("glGenBuffersARB"));
+        glDeleteBuffers = reinterpret_cast<Delete_Buffers_Func>(Get_Function("glDeleteBuffersARB"));
+        glBindBuffer = reinterpret_cast<Bind_Buffer_Func>(Get_Function("glBindBufferARB"));
+        glBufferData = reinterpret_cast<Buffer_Data_Func>(Get_Function("glBufferDataARB"));
+    }
+    else {
+        glGenBuffers = NULL;
+        glDeleteBuffers = NULL;
+        glBindBuffer = NULL;
+        glBufferData = NULL;
+    }
+
+    m_vertex_buffers = glGenBuffers && glDeleteBuffers && glBindBuffer && glBufferData;
+
+    debug_print("OpenGL vertex buffer objects : %s\n", m_vertex_buffers ? "available" : "not available, using client side vertex arrays");
+
+    m_shaders = 0;
+
+    // core since 2.0, the ARB extensions use other functions
+    if (major >= 2) {
+        const char* glsl_version_str = reinterpret_cast<const char*>(glGetString(GL_SHADING_LANGUAGE_VERSION));
+        int glsl_major = 0;
+        int glsl_minor = 0;
+
+        if (glsl_version_str) {
+            sscanf(glsl_version_str, "%d.%d", &glsl_major, &glsl_minor);
+        }
+
+        // GLSL 1.20
+        if (glsl_major > 1 || (glsl_major == 1 && glsl_minor >= 20)) {
+            m_shaders = Init_Shaders();
+        }
+    }
+
+    debug_print("OpenGL shaders : %s\n", m_shaders ? "available" : "not available, using the fixed function pipeline");
+}
+
+bool cGL_Extensions::Init_Shaders(void)
+{
+    glCreateShader = reinterpret_cast<Create_Shader_Func>(Get_Function("glCreateShader"));
+    glDeleteShader = reinterpret_cast<Delete_Shader_Func>(Get_Function("glDeleteShader"));
+    glShaderSource = reinterpret_cast<Shader_Source_Func>(Get_Function("glShaderSource"));
+    glCompileShader = reinterpret_cast<Compile_Shader_Func>(Get_Function("glCompileShader"));
+    glGetShaderiv = reinterpret_cast<Get_Shader_Iv_Func>(Get_Function("glGetShaderiv"));
+    glGetShaderInfoLog = reinterpret_cast<Get_Info_Log_Func>(Get_Function("glGetShaderInfoLog"));
+    glCreateProgram = reinterpret_cast<Create_Program_Func>(Get_Function("glCreateProgram"));
+    glDeleteProgram = reinterpret_cast<Delete_Program_Func>(Get_Function("glDeleteProgram"));
+    glAttachShader = reinterpret_cast<Attach_Shader_Func>(Get_Function("glAttachShader"));
+    glBindAttribLocation = reinterpret_cast<Bind_Attrib_Location_Func>(Get_Function("glBindAttribLocation"));
+    glLinkProgram = reinterpret_cast<Link_Program_Func>(Get_Function("glLinkProgram"));
+    glGetProgramiv = reinterpret_cast<Get_Program_Iv_Func>(Get_Function("glGetProgramiv"));
+    glGetProgramInfoLog = reinterpret_cast<Get_Info_Log_Func>(Get_Function("glGetProgramInfoLog"));
+    glUseProgram = reinterpret_cast<Use_Program_Func>(Get_Function("glUseProgram"));
+    glGetUniformLocation = reinterpret_cast<Get_Uniform_Location_Func>(Get_Function("glGetUniformLocation"));
+    glUniform1i = reinterpret_cast<Uniform_1i_Func>(Get_Function("glUniform1i"));
+    glEnableVertexAttribArray = reinterpret_cast<Vertex_Attrib_Array_Func>(Get_Function("glEnableVertexAttribArray"));
+    glDisableVertexAttribArray = reinterpret_cast<Vertex_Attrib_Array_Func>(Get_Function("glDisableVertexAttribArray"));
+    glVertexAttribPointer = reinterpret_cast<Vertex_Attrib_Pointer_Func>(Get_Function("glVertexAttribPointer"));
+
+    return glCreateShader && glDeleteShader && glShaderSource && glCompileShader && glGetShaderiv && glGetShaderInfoLog &&
+           glCreateProgram && glDeleteProgram && glAttachShader && glBindAttribLocation && glLinkProgram && glGetProgramiv &&
+           glGetProgramInfoLog && glUseProgram && glGetUniformLocation && glUniform1i &&
+           glEnableVertexAttribArray && glDisableVertexAttribArray && glVertexAttribPointer;
+}
+
+void* cGL_Extensions::Get_Function(const char* name) const
+{
+#if defined(_WIN32)
+    return reinterpret_cast<void*>(wglGetProcAddress(name));
+#elif defined(__APPLE__)
+    // the OpenGL framework exports all functions of the supported versions
+    return dlsym(RTLD_DEFAULT, name);
+#elif defined(__unix__)
+    return reinterpret_cast<void*>(glXGetProcAddressARB(reinterpret_cast<const GLubyte*>(name)));
+#else
+    return NULL;
+#endif
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,146 @@
+/***************************************************************************
+ * gl_extensions.hpp - OpenGL functions above version 1.1
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_GL_EXTENSIONS_HPP
+#define TSC_GL_EXTENSIONS_HPP
+
+#include "../core/global_basic.hpp"
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// OpenGL 1.5 tokens missing in old headers
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+// OpenGL 2.0 tokens
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_SHADING_LANGUAGE_VERSION
+#define GL_SHADING_LANGUAGE_VERSION 0x8B8C
+#endif
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** cGL_Extensions *** *** *** *** *** *** *** *** *** *** */
+
+    /* Function pointers for the OpenGL features we use above version 1.1
+     * which is all the system headers are guaranteed to provide.
+     * Must be initialized again for every new context.
+     */
+    class cGL_Extensions {
+    public:
+        cGL_Extensions(void);
+        ~cGL_Extensions(void);
+
+        // Load the functions from the current context
+        void Init(void);
+
+        // Returns true if vertex buffer objects are available
+        inline bool Has_Vertex_Buffers(void) const
+        {
+            return m_vertex_buffers;
+        }
+        // Returns true if GLSL 1.20 shaders are available
+        inline bool Has_Shaders(void) const
+        {
+            return m_shaders;
+        }
+
+        typedef void (APIENTRY* Gen_Buffers_Func)(GLsizei n, GLuint* buffers);
+        typedef void (APIENTRY* Delete_Buffers_Func)(GLsizei n, const GLuint* buffers);
+        typedef void (APIENTRY* Bind_Buffer_Func)(GLenum target, GLuint buffer);
+        typedef void (APIENTRY* Buffer_Data_Func)(GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+
+        // vertex buffer objects (OpenGL 1.5)
+        Gen_Buffers_Func glGenBuffers;
+        Delete_Buffers_Func glDeleteBuffers;
+        Bind_Buffer_Func glBindBuffer;
+        Buffer_Data_Func glBufferData;
+
+        typedef GLuint (APIENTRY* Create_Shader_Func)(GLenum type);
+        typedef void (APIENTRY* Delete_Shader_Func)(GLuint shader);
+        typedef void (APIENTRY* Shader_Source_Func)(GLuint shader, GLsizei count, const char* const* string, const GLint* length);
+        typedef void (APIENTRY* Compile_Shader_Func)(GLuint shader);
+        typedef void (APIENTRY* Get_Shader_Iv_Func)(GLuint shader, GLenum pname, GLint* params);
+        typedef void (APIENTRY* Get_Info_Log_Func)(GLuint object, GLsizei max_length, GLsizei* length, char* info_log);
+        typedef GLuint (APIENTRY* Create_Program_Func)(void);
+        typedef void (APIENTRY* Delete_Program_Func)(GLuint program);
+        typedef void (APIENTRY* Attach_Shader_Func)(GLuint program, GLuint shader);
+        typedef void (APIENTRY* Bind_Attrib_Location_Func)(GLuint program, GLuint index, const char* name);
+        typedef void (APIENTRY* Link_Program_Func)(GLuint program);
+        typedef void (APIENTRY* Get_Program_Iv_Func)(GLuint program, GLenum pname, GLint* params);
+        typedef void (APIENTRY* Use_Program_Func)(GLuint program);
+        typedef GLint (APIENTRY* Get_Uniform_Location_Func)(GLuint program, const char* name);
+        typedef void (APIENTRY* Uniform_1i_Func)(GLint location, GLint v0);
+        typedef void (APIENTRY* Vertex_Attrib_Array_Func)(GLuint index);
+        typedef void (APIENTRY* Vertex_Attrib_Pointer_Func)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+
+        // shader objects (OpenGL 2.0)
+        Create_Shader_Func glCreateShader;
+        Delete_Shader_Func glDeleteShader;
+        Shader_Source_Func glShaderSource;
+        Compile_Shader_Func glCompileShader;
+        Get_Shader_Iv_Func glGetShaderiv;
+        Get_Info_Log_Func glGetShaderInfoLog;
+        Create_Program_Func glCreateProgram;
+        Delete_Program_Func glDeleteProgram;
+        Attach_Shader_Func glAttachShader;
+        Bind_Attrib_Location_Func glBindAttribLocation;
+        Link_Program_Func glLinkProgram;
+        Get_Program_Iv_Func glGetProgramiv;
+        Get_Info_Log_Func glGetProgramInfoLog;
+        Use_Program_Func glUseProgram;
+        Get_Uniform_Location_Func glGetUniformLocation;
+        Uniform_1i_Func glUniform1i;
+        Vertex_Attrib_Array_Func glEnableVertexAttribArray;
+        Vertex_Attrib_Array_Func glDisableVertexAttribArray;
+        Vertex_Attrib_Pointer_Func glVertexAttribPointer;
+
+        // increased for every new context, objects of older contexts are invalid
+        unsigned int m_context_num;
+
+    private:
+        // Return the address of the given function or NULL if not available
+        void* Get_Function(const char* name) const;
+        // Load the shader functions and return true if all are available
+        bool Init_Shaders(void);
+
+        bool m_vertex_buffers;
+        bool m_shaders;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
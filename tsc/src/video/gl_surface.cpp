@@ -42,6 +42,12 @@ cGL_Surface::cGL_Surface(void)
     m_h = 0;
     m_tex_w = 0;
     m_tex_h = 0;
+    m_tex_left = 0.0f;
+    m_tex_top = 0.0f;
+    m_tex_right = 1.0f;
+    m_tex_bottom = 1.0f;
+    m_atlas = 0;
+    m_opaque = 0;
 
     // internal rotation data
     m_base_rot_x = 0;
@@ -69,8 +75,9 @@ cGL_Surface::cGL_Surface(void)
 cGL_Surface::~cGL_Surface(void)
 {
     // don't delete a managed OpenGL image if still in use by another managed cGL_Surface
-    if (m_auto_del_img && glIsTexture(m_image) && (!m_managed || !Is_Texture_Use_Multiple())) {
-        glDeleteTextures(1, &m_image);
+    // atlas pages are deleted by the atlas
+    if (m_auto_del_img && !m_atlas && m_image && pVideo && (!m_managed || !Is_Texture_Use_Multiple())) {
+        pVideo->Delete_Texture(m_image);
     }
 
     if (destruction_function) {
@@ -93,6 +100,12 @@ cGL_Surface* cGL_Surface::Copy(void) const
     new_surface->m_h = m_h;
     new_surface->m_tex_h = m_tex_h;
     new_surface->m_tex_w = m_tex_w;
+    new_surface->m_tex_left = m_tex_left;
+    new_surface->m_tex_top = m_tex_top;
+    new_surface->m_tex_right = m_tex_right;
+    new_surface->m_tex_bottom = m_tex_bottom;
+    new_surface->m_atlas = m_atlas;
+    new_surface->m_opaque = m_opaque;
     new_surface->m_base_rot_x = m_base_rot_x;
     new_surface->m_base_rot_y = m_base_rot_y;
     new_surface->m_base_rot_z = m_base_rot_z;
@@ -138,6 +151,12 @@ void cGL_Surface::Blit_Data(cSurface_Request* request) const
 {
     // texture id
     request->m_texture_id = m_image;
+    request->m_opaque = m_opaque;
+    // texture coordinates
+    request->m_tex_left = m_tex_left;
+    request->m_tex_top = m_tex_top;
+    request->m_tex_right = m_tex_right;
+    request->m_tex_bottom = m_tex_bottom;
 
     // position
     request->m_pos_x += m_int_x;
@@ -163,6 +182,34 @@ void cGL_Surface::Save(const std::string& filename)
     // bind the texture
     glBindTexture(GL_TEXTURE_2D, m_image);
 
+    // only save our part of the atlas page
+    if (m_atlas) {
+        GLint page_w = 0;
+        GLint page_h = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &page_w);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &page_h);
+
+        // read page
+        GLubyte* page_data = new GLubyte[page_w * page_h * 4];
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<GLvoid*>(page_data));
+
+        const unsigned int left = static_cast<unsigned int>(m_tex_left * page_w + 0.5f);
+        const unsigned int top = static_cast<unsigned int>(m_tex_top * page_h + 0.5f);
+
+        GLubyte* data = new GLubyte[m_tex_w * m_tex_h * 4];
+
+        for (unsigned int y = 0; y < m_tex_h; y++) {
+            memcpy(&data[y * m_tex_w * 4], &page_data[((top + y) * page_w + left) * 4], m_tex_w * 4);
+        }
+
+        delete[] page_data;
+        // save
+        pVideo->Save_Surface(filename, data, m_tex_w, m_tex_h);
+        // clear data
+        delete[] data;
+        return;
+    }
+
     // create image data
     GLubyte* data = new GLubyte[m_tex_w * m_tex_h * 4];
     // read texture
@@ -200,7 +247,8 @@ cSaved_Texture* cGL_Surface::Get_Software_Texture(bool only_filename /* = 0 */)
     cSaved_Texture* soft_tex = new cSaved_Texture();
 
     // hardware texture to software texture
-    if (!only_filename) {
+    // atlas pages are shared and the image is loaded again from its file instead
+    if (!only_filename && !m_atlas) {
         // bind the texture
         glBindTexture(GL_TEXTURE_2D, m_image);
 
@@ -272,7 +320,7 @@ void cGL_Surface::Load_Software_Texture(cSaved_Texture* soft_tex)
     }
     // load from file
     else {
-        cGL_Surface* surface_copy = pVideo->Load_GL_Surface(m_path);
+        cGL_Surface* surface_copy = pVideo->Load_GL_Surface_Helper(m_path, 1, 1, 0, m_atlas);
 
         if (!surface_copy) {
             cerr << "Warning: cGL_Surface :: Load_Software_Texture " << m_path.c_str() << " loading failed" << endl;
@@ -283,6 +331,11 @@ void cGL_Surface::Load_Software_Texture(cSaved_Texture* soft_tex)
         m_image = surface_copy->m_image;
         m_tex_w = surface_copy->m_tex_w;
         m_tex_h = surface_copy->m_tex_h;
+        m_tex_left = surface_copy->m_tex_left;
+        m_tex_top = surface_copy->m_tex_top;
+        m_tex_right = surface_copy->m_tex_right;
+        m_tex_bottom = surface_copy->m_tex_bottom;
+        m_atlas = surface_copy->m_atlas;
         // keep hardware texture
         surface_copy->m_auto_del_img = 0;
         // delete copy
@@ -290,6 +343,35 @@ void cGL_Surface::Load_Software_Texture(cSaved_Texture* soft_tex)
     }
 }
 
+void cGL_Surface::Leave_Atlas(void)
+{
+    // already a texture of its own
+    if (!m_atlas) {
+        return;
+    }
+
+    cGL_Surface* surface_copy = pVideo->Load_GL_Surface_Helper(m_path, 1, 1, 0, 0);
+
+    if (!surface_copy) {
+        cerr << "Warning: cGL_Surface :: Leave_Atlas " << m_path.c_str() << " loading failed" << endl;
+        return;
+    }
+
+    // get image
+    m_image = surface_copy->m_image;
+    m_tex_w = surface_copy->m_tex_w;
+    m_tex_h = surface_copy->m_tex_h;
+    m_tex_left = surface_copy->m_tex_left;
+    m_tex_top = surface_copy->m_tex_top;
+    m_tex_right = surface_copy->m_tex_right;
+    m_tex_bottom = surface_copy->m_tex_bottom;
+    m_atlas = 0;
+    // keep hardware texture
+    surface_copy->m_auto_del_img = 0;
+    // delete copy
+    delete surface_copy;
+}
+
 fs::path cGL_Surface::Get_Path()
 {
     return m_path;
@@ -54,6 +54,10 @@ namespace TSC {
         cSaved_Texture* Get_Software_Texture(bool only_filename = 0);
         // Load a software texture
         void Load_Software_Texture(cSaved_Texture* soft_tex);
+        /* Load the image again into a texture of its own if it is in an atlas page
+         * needed to repeat the texture, the space in the page is kept until the atlas gets cleared
+        */
+        void Leave_Atlas(void);
 
         // Return the filename if created from a file, otherwise an
         // empty boost::filesystem::path instance.
@@ -79,6 +83,15 @@ namespace TSC {
         // texture dimension
         unsigned int m_tex_w;
         unsigned int m_tex_h;
+        // texture coordinates of the image, only not 0 to 1 if in an atlas
+        float m_tex_left;
+        float m_tex_top;
+        float m_tex_right;
+        float m_tex_bottom;
+        // if the texture is an atlas page shared with other images
+        bool m_atlas;
+        // if every texture pixel is fully opaque
+        bool m_opaque;
         // internal rotation
         float m_base_rot_x;
         float m_base_rot_y;
@@ -16,6 +16,7 @@
 
 #include "../video/img_manager.hpp"
 #include "../video/renderer.hpp"
+#include "../video/video.hpp"
 #include "../video/loading_screen.hpp"
 #include "../core/i18n.hpp"
 #include "../core/global_basic.hpp"
@@ -136,8 +137,8 @@ void cImage_Manager::Grab_Textures(bool from_file /* = 0 */, bool draw_gui /* =
 
         // get software texture and save it to software memory
         m_saved_textures.push_back(obj->Get_Software_Texture(from_file));
-        // delete hardware texture
-        if (glIsTexture(obj->m_image)) {
+        // delete hardware texture, atlas pages are deleted afterwards
+        if (!obj->m_atlas && glIsTexture(obj->m_image)) {
             glDeleteTextures(1, &obj->m_image);
         }
 
@@ -152,6 +153,9 @@ void cImage_Manager::Grab_Textures(bool from_file /* = 0 */, bool draw_gui /* =
             Loading_Screen_Draw();
         }
     }
+
+    // atlas images are loaded again from their files
+    m_atlas.Clear();
 }
 
 void cImage_Manager::Restore_Textures(bool draw_gui /* = 0 */)
@@ -201,10 +205,12 @@ void cImage_Manager::Delete_Image_Textures(void)
         // get object
         cGL_Surface* obj = (*itr);
 
-        if (obj->m_auto_del_img && glIsTexture(obj->m_image)) {
-            glDeleteTextures(1, &obj->m_image);
+        if (obj->m_auto_del_img && !obj->m_atlas) {
+            pVideo->Delete_Texture(obj->m_image);
         }
     }
+
+    m_atlas.Clear();
 }
 
 bool cImage_Manager::Delete(size_t array_num, bool delete_data)
@@ -21,6 +21,7 @@
 #include "../video/video.hpp"
 #include "../core/obj_manager.hpp"
 #include "../video/gl_surface.hpp"
+#include "../video/texture_atlas.hpp"
 
 namespace TSC {
 
@@ -111,6 +112,8 @@ namespace TSC {
 
         // highest opengl texture id found
         GLuint m_high_texture_id;
+        // shared textures of the small managed images
+        cTexture_Atlas m_atlas;
 
     private:
         // saved textures for reloading
@@ -100,6 +100,9 @@ void TSC::Loading_Screen_Set_Progress(float progress)
 
 void TSC::Loading_Screen_Draw(void)
 {
+    // renders directly
+    pVideo->Render_Finish();
+
     // limit fps or vsync will slow down the loading
     if (!Is_Frame_Time(60)) {
         pRenderer->Fake_Render();
@@ -0,0 +1,164 @@
+/***************************************************************************
+ * particle_budget.cpp - Limits the live particles of all emitters
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/particle_budget.hpp"
+#include "../core/framerate.hpp"
+#include "../user/preferences.hpp"
+
+using namespace std;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** cParticle_Budget *** *** *** *** *** *** *** *** *** *** */
+
+// gameplay effects keep at least half of their particles
+const float cParticle_Budget::m_min_emit_factor[PARTICLE_PRIORITY_COUNT] = {0.1f, 0.5f};
+// part of the speed factor target the average frames per second must fall below
+static const float particle_budget_fps_margin = 0.9f;
+
+cParticle_Budget::cParticle_Budget(void)
+{
+    for (unsigned int i = 0; i < PARTICLE_PRIORITY_COUNT; i++) {
+        m_live_particles[i] = 0;
+        m_counted_particles[i] = 0;
+        m_emit_factor[i] = 1.0f;
+    }
+
+    m_average_fps = 0.0f;
+    m_over_budget = 0;
+    m_over_frame_time = 0;
+}
+
+cParticle_Budget::~cParticle_Budget(void)
+{
+    m_emitters.clear();
+}
+
+void cParticle_Budget::Register(cParticle_Emitter* emitter)
+{
+    m_emitters.push_back(emitter);
+}
+
+void cParticle_Budget::Unregister(cParticle_Emitter* emitter)
+{
+    vector<cParticle_Emitter*>::iterator itr = std::find(m_emitters.begin(), m_emitters.end(), emitter);
+
+    if (itr != m_emitters.end()) {
+        // the order is not needed
+        *itr = m_emitters.back();
+        m_emitters.pop_back();
+    }
+}
+
+void cParticle_Budget::Update(void)
+{
+    for (unsigned int i = 0; i < PARTICLE_PRIORITY_COUNT; i++) {
+        m_live_particles[i] = m_counted_particles[i];
+        m_counted_particles[i] = 0;
+    }
+
+    const unsigned int live_particles = Get_Live_Particles();
+    const unsigned int max_particles = pPreferences->m_video_particle_max;
+
+    m_over_budget = max_particles > 0 && live_particles > max_particles;
+
+    // a single slow frame should not lower the factors
+    if (m_average_fps <= 0.0f) {
+        m_average_fps = pFramerate->m_fps;
+    }
+    else {
+        m_average_fps += (pFramerate->m_fps - m_average_fps) * 0.1f;
+    }
+
+    // only switch when clearly below or back at the target
+    if (live_particles == 0) {
+        m_over_frame_time = 0;
+    }
+    else if (m_over_frame_time) {
+        m_over_frame_time = m_average_fps < pFramerate->m_fps_target;
+    }
+    else {
+        m_over_frame_time = m_average_fps < pFramerate->m_fps_target * particle_budget_fps_margin;
+    }
+
+    float& ambience = m_emit_factor[PARTICLE_PRIORITY_AMBIENCE];
+    float& gameplay = m_emit_factor[PARTICLE_PRIORITY_GAMEPLAY];
+
+    // lower the ambience first
+    if (m_over_budget || m_over_frame_time) {
+        if (ambience > m_min_emit_factor[PARTICLE_PRIORITY_AMBIENCE]) {
+            ambience = max(ambience * 0.9f, m_min_emit_factor[PARTICLE_PRIORITY_AMBIENCE]);
+        }
+        else {
+            gameplay = max(gameplay * 0.9f, m_min_emit_factor[PARTICLE_PRIORITY_GAMEPLAY]);
+        }
+    }
+    // raise the gameplay first if well below the maximum
+    else if (max_particles == 0 || live_particles < max_particles * 0.8f) {
+        if (gameplay < 1.0f) {
+            gameplay = min(gameplay + 0.02f, 1.0f);
+        }
+        else {
+            ambience = min(ambience + 0.02f, 1.0f);
+        }
+    }
+}
+
+void cParticle_Budget::Add_Live_Particles(ParticlePriority priority, unsigned int count)
+{
+    m_counted_particles[priority] += count;
+}
+
+bool cParticle_Budget::Is_Full(ParticlePriority priority) const
+{
+    // gameplay effects are only slowed down
+    if (priority == PARTICLE_PRIORITY_GAMEPLAY) {
+        return 0;
+    }
+
+    const unsigned int max_particles = pPreferences->m_video_particle_max;
+
+    return max_particles > 0 && Get_Live_Particles() >= max_particles;
+}
+
+bool cParticle_Budget::Is_Throttled(void) const
+{
+    for (unsigned int i = 0; i < PARTICLE_PRIORITY_COUNT; i++) {
+        if (m_emit_factor[i] < 1.0f) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+unsigned int cParticle_Budget::Get_Live_Particles(void) const
+{
+    unsigned int count = 0;
+
+    for (unsigned int i = 0; i < PARTICLE_PRIORITY_COUNT; i++) {
+        count += m_live_particles[i];
+    }
+
+    return count;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cParticle_Budget* pParticle_Budget = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
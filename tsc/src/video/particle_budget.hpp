@@ -0,0 +1,124 @@
+/***************************************************************************
+ * particle_budget.hpp - Limits the live particles of all emitters
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_PARTICLE_BUDGET_HPP
+#define TSC_PARTICLE_BUDGET_HPP
+
+#include "../core/global_basic.hpp"
+
+namespace TSC {
+
+    class cParticle_Emitter;
+
+    /* *** *** *** *** *** *** *** Particle priority *** *** *** *** *** *** *** *** *** *** */
+
+    enum ParticlePriority {
+        // level emitters like weather which are throttled first
+        PARTICLE_PRIORITY_AMBIENCE = 0,
+        // spawned effects giving feedback to the player
+        PARTICLE_PRIORITY_GAMEPLAY = 1,
+        PARTICLE_PRIORITY_COUNT = 2
+    };
+
+    /* *** *** *** *** *** *** *** cParticle_Budget *** *** *** *** *** *** *** *** *** *** */
+
+    /* Every particle emitter registers here and counts its live particles
+     * each frame. If the count is over the maximum from the preferences or
+     * the average frame is slower than the speed factor target, the emit factor of
+     * the ambience is lowered and only then the one of the gameplay.
+     * Emitters divide their iteration interval by it and multiply their
+     * quota with it. The factors rise again when the count is well below
+     * the maximum and the frame is fast enough.
+     */
+    class cParticle_Budget {
+    public:
+        cParticle_Budget(void);
+        ~cParticle_Budget(void);
+
+        // Add an emitter
+        void Register(cParticle_Emitter* emitter);
+        // Remove an emitter
+        void Unregister(cParticle_Emitter* emitter);
+
+        /* Set the emit factors from the particles counted since the last call
+         * and start counting again, called once per frame
+        */
+        void Update(void);
+        // Count the live particles of an emitter updated in this frame
+        void Add_Live_Particles(ParticlePriority priority, unsigned int count);
+
+        // Return the factor from the minimum to 1 to scale the emission with
+        inline float Get_Emit_Factor(ParticlePriority priority) const
+        {
+            return m_emit_factor[priority];
+        }
+        // Return true if the emitters should not emit new particles at all
+        bool Is_Full(ParticlePriority priority) const;
+        // Return true if any emit factor is lowered
+        bool Is_Throttled(void) const;
+
+        // Return the registered emitter count
+        inline unsigned int Get_Emitter_Count(void) const
+        {
+            return m_emitters.size();
+        }
+        // Return the live particles of the last frame
+        unsigned int Get_Live_Particles(void) const;
+        // Return the live particles of the given priority of the last frame
+        inline unsigned int Get_Live_Particles(ParticlePriority priority) const
+        {
+            return m_live_particles[priority];
+        }
+        // Return true if the last frame was over the particle maximum
+        inline bool Is_Over_Budget(void) const
+        {
+            return m_over_budget;
+        }
+        // Return true if the frames are slower than the speed factor target
+        inline bool Is_Over_Frame_Time(void) const
+        {
+            return m_over_frame_time;
+        }
+
+    private:
+        vector<cParticle_Emitter*> m_emitters;
+        // live particles counted in this frame
+        unsigned int m_counted_particles[PARTICLE_PRIORITY_COUNT];
+        // live particles of the last frame
+        unsigned int m_live_particles[PARTICLE_PRIORITY_COUNT];
+        // current emit factors
+        float m_emit_factor[PARTICLE_PRIORITY_COUNT];
+        // lowest emit factors
+        static const float m_min_emit_factor[PARTICLE_PRIORITY_COUNT];
+        // frames per second smoothed over the last frames
+        float m_average_fps;
+        // if the last frame was over the particle maximum
+        bool m_over_budget;
+        /* if the average frame is slower than the speed factor target
+         * set below a margin under the target and cleared at the target
+        */
+        bool m_over_frame_time;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Particle Budget
+    extern cParticle_Budget* pParticle_Budget;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -0,0 +1,336 @@
+/***************************************************************************
+ * particle_kernel.cpp - Vectorized particle update loops
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/particle_kernel.hpp"
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TSC_PARTICLE_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** Scalar *** *** *** *** *** *** *** *** *** *** */
+
+// the scalar loops start at the given particle to finish the vectorized ones
+
+static void Integrate_Scalar(const Particle_Kernel_Arrays& particles, unsigned int start, float fade_speed, float speed_factor)
+{
+    const unsigned int count = particles.m_count;
+
+    float* pos_x = particles.m_pos_x;
+    float* pos_y = particles.m_pos_y;
+    float* vel_x = particles.m_vel_x;
+    float* vel_y = particles.m_vel_y;
+    const float* gravity_x = particles.m_gravity_x;
+    const float* gravity_y = particles.m_gravity_y;
+    float* fade_pos = particles.m_fade_pos;
+    const float* time_to_live = particles.m_time_to_live;
+
+    for (unsigned int i = start; i < count; i++) {
+        fade_pos[i] -= fade_speed / time_to_live[i];
+
+        pos_x[i] += vel_x[i] * speed_factor;
+        pos_y[i] += vel_y[i] * speed_factor;
+        // todo : gravity maximum
+        vel_x[i] += gravity_x[i] * speed_factor;
+        vel_y[i] += gravity_y[i] * speed_factor;
+    }
+}
+
+static void Fade_Size_Scalar(const Particle_Kernel_Arrays& particles, unsigned int start)
+{
+    const unsigned int count = particles.m_count;
+
+    float* scale = particles.m_scale;
+    const float* start_scale = particles.m_start_scale;
+    const float* fade_pos = particles.m_fade_pos;
+
+    for (unsigned int i = start; i < count; i++) {
+        // finished particles are removed afterwards
+        if (fade_pos[i] > 0.0f) {
+            scale[i] = start_scale[i] * fade_pos[i];
+        }
+    }
+}
+
+static void Rotate_Scalar(float* rot, const float* const_rot, unsigned int start, unsigned int count, float speed_factor)
+{
+    for (unsigned int i = start; i < count; i++) {
+        // not 0 with the tolerance of Is_Float_Equal()
+        if (!(fabs(const_rot[i]) <= 0.0001f)) {
+            rot[i] = fmod(rot[i] + (const_rot[i] * speed_factor), 360.0f);
+        }
+    }
+}
+
+#ifdef TSC_PARTICLE_KERNEL_X86
+
+/* *** *** *** *** *** *** *** SSE2 *** *** *** *** *** *** *** *** *** *** */
+
+// 4 particles per iteration
+
+__attribute__((target("sse2")))
+static void Integrate_SSE2(const Particle_Kernel_Arrays& particles, float fade_speed, float speed_factor)
+{
+    const unsigned int count = particles.m_count & ~3u;
+
+    float* pos_x = particles.m_pos_x;
+    float* pos_y = particles.m_pos_y;
+    float* vel_x = particles.m_vel_x;
+    float* vel_y = particles.m_vel_y;
+    const float* gravity_x = particles.m_gravity_x;
+    const float* gravity_y = particles.m_gravity_y;
+    float* fade_pos = particles.m_fade_pos;
+    const float* time_to_live = particles.m_time_to_live;
+
+    const __m128 fade_speed4 = _mm_set1_ps(fade_speed);
+    const __m128 speed_factor4 = _mm_set1_ps(speed_factor);
+
+    for (unsigned int i = 0; i < count; i += 4) {
+        _mm_storeu_ps(fade_pos + i, _mm_sub_ps(_mm_loadu_ps(fade_pos + i), _mm_div_ps(fade_speed4, _mm_loadu_ps(time_to_live + i))));
+
+        const __m128 vx = _mm_loadu_ps(vel_x + i);
+        const __m128 vy = _mm_loadu_ps(vel_y + i);
+        _mm_storeu_ps(pos_x + i, _mm_add_ps(_mm_loadu_ps(pos_x + i), _mm_mul_ps(vx, speed_factor4)));
+        _mm_storeu_ps(pos_y + i, _mm_add_ps(_mm_loadu_ps(pos_y + i), _mm_mul_ps(vy, speed_factor4)));
+        _mm_storeu_ps(vel_x + i, _mm_add_ps(vx, _mm_mul_ps(_mm_loadu_ps(gravity_x + i), speed_factor4)));
+        _mm_storeu_ps(vel_y + i, _mm_add_ps(vy, _mm_mul_ps(_mm_loadu_ps(gravity_y + i), speed_factor4)));
+    }
+
+    Integrate_Scalar(particles, count, fade_speed, speed_factor);
+}
+
+__attribute__((target("sse2")))
+static void Fade_Size_SSE2(const Particle_Kernel_Arrays& particles)
+{
+    const unsigned int count = particles.m_count & ~3u;
+
+    float* scale = particles.m_scale;
+    const float* start_scale = particles.m_start_scale;
+    const float* fade_pos = particles.m_fade_pos;
+
+    const __m128 zero = _mm_setzero_ps();
+
+    for (unsigned int i = 0; i < count; i += 4) {
+        const __m128 fade = _mm_loadu_ps(fade_pos + i);
+        const __m128 fading = _mm_cmpgt_ps(fade, zero);
+        const __m128 faded = _mm_mul_ps(_mm_loadu_ps(start_scale + i), fade);
+        const __m128 old_scale = _mm_loadu_ps(scale + i);
+
+        _mm_storeu_ps(scale + i, _mm_or_ps(_mm_and_ps(fading, faded), _mm_andnot_ps(fading, old_scale)));
+    }
+
+    Fade_Size_Scalar(particles, count);
+}
+
+__attribute__((target("sse2")))
+static void Rotate_SSE2(float* rot, const float* const_rot, unsigned int count, float speed_factor)
+{
+    const unsigned int count4 = count & ~3u;
+
+    const __m128 speed_factor4 = _mm_set1_ps(speed_factor);
+    const __m128 full_rotation = _mm_set1_ps(360.0f);
+    const __m128 tolerance = _mm_set1_ps(0.0001f);
+    const __m128 sign_bit = _mm_set1_ps(-0.0f);
+
+    for (unsigned int i = 0; i < count4; i += 4) {
+        const __m128 old_rot = _mm_loadu_ps(rot + i);
+        const __m128 rot_speed = _mm_loadu_ps(const_rot + i);
+
+        const __m128 sum = _mm_add_ps(old_rot, _mm_mul_ps(rot_speed, speed_factor4));
+        // like fmod : subtract the full rotations rounded towards zero
+        const __m128 full_rotations = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(sum, full_rotation)));
+        __m128 new_rot = _mm_sub_ps(sum, _mm_mul_ps(full_rotations, full_rotation));
+        // fmod keeps the sign of the dividend, also for -360 giving -0
+        new_rot = _mm_or_ps(_mm_andnot_ps(sign_bit, new_rot), _mm_and_ps(sign_bit, sum));
+
+        // only if the constant rotation is not 0
+        const __m128 rotating = _mm_cmpgt_ps(_mm_andnot_ps(sign_bit, rot_speed), tolerance);
+        _mm_storeu_ps(rot + i, _mm_or_ps(_mm_and_ps(rotating, new_rot), _mm_andnot_ps(rotating, old_rot)));
+    }
+
+    Rotate_Scalar(rot, const_rot, count4, count, speed_factor);
+}
+
+/* *** *** *** *** *** *** *** AVX *** *** *** *** *** *** *** *** *** *** */
+
+// 8 particles per iteration
+
+__attribute__((target("avx")))
+static void Integrate_AVX(const Particle_Kernel_Arrays& particles, float fade_speed, float speed_factor)
+{
+    const unsigned int count = particles.m_count & ~7u;
+
+    float* pos_x = particles.m_pos_x;
+    float* pos_y = particles.m_pos_y;
+    float* vel_x = particles.m_vel_x;
+    float* vel_y = particles.m_vel_y;
+    const float* gravity_x = particles.m_gravity_x;
+    const float* gravity_y = particles.m_gravity_y;
+    float* fade_pos = particles.m_fade_pos;
+    const float* time_to_live = particles.m_time_to_live;
+
+    const __m256 fade_speed8 = _mm256_set1_ps(fade_speed);
+    const __m256 speed_factor8 = _mm256_set1_ps(speed_factor);
+
+    for (unsigned int i = 0; i < count; i += 8) {
+        _mm256_storeu_ps(fade_pos + i, _mm256_sub_ps(_mm256_loadu_ps(fade_pos + i), _mm256_div_ps(fade_speed8, _mm256_loadu_ps(time_to_live + i))));
+
+        const __m256 vx = _mm256_loadu_ps(vel_x + i);
+        const __m256 vy = _mm256_loadu_ps(vel_y + i);
+        _mm256_storeu_ps(pos_x + i, _mm256_add_ps(_mm256_loadu_ps(pos_x + i), _mm256_mul_ps(vx, speed_factor8)));
+        _mm256_storeu_ps(pos_y + i, _mm256_add_ps(_mm256_loadu_ps(pos_y + i), _mm256_mul_ps(vy, speed_factor8)));
+        _mm256_storeu_ps(vel_x + i, _mm256_add_ps(vx, _mm256_mul_ps(_mm256_loadu_ps(gravity_x + i), speed_factor8)));
+        _mm256_storeu_ps(vel_y + i, _mm256_add_ps(vy, _mm256_mul_ps(_mm256_loadu_ps(gravity_y + i), speed_factor8)));
+    }
+
+    Integrate_Scalar(particles, count, fade_speed, speed_factor);
+}
+
+__attribute__((target("avx")))
+static void Fade_Size_AVX(const Particle_Kernel_Arrays& particles)
+{
+    const unsigned int count = particles.m_count & ~7u;
+
+    float* scale = particles.m_scale;
+    const float* start_scale = particles.m_start_scale;
+    const float* fade_pos = particles.m_fade_pos;
+
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (unsigned int i = 0; i < count; i += 8) {
+        const __m256 fade = _mm256_loadu_ps(fade_pos + i);
+        const __m256 fading = _mm256_cmp_ps(fade, zero, _CMP_GT_OQ);
+        const __m256 faded = _mm256_mul_ps(_mm256_loadu_ps(start_scale + i), fade);
+
+        _mm256_storeu_ps(scale + i, _mm256_or_ps(_mm256_and_ps(fading, faded), _mm256_andnot_ps(fading, _mm256_loadu_ps(scale + i))));
+    }
+
+    Fade_Size_Scalar(particles, count);
+}
+
+__attribute__((target("avx")))
+static void Rotate_AVX(float* rot, const float* const_rot, unsigned int count, float speed_factor)
+{
+    const unsigned int count8 = count & ~7u;
+
+    const __m256 speed_factor8 = _mm256_set1_ps(speed_factor);
+    const __m256 full_rotation = _mm256_set1_ps(360.0f);
+    const __m256 tolerance = _mm256_set1_ps(0.0001f);
+    const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+
+    for (unsigned int i = 0; i < count8; i += 8) {
+        const __m256 old_rot = _mm256_loadu_ps(rot + i);
+        const __m256 rot_speed = _mm256_loadu_ps(const_rot + i);
+
+        const __m256 sum = _mm256_add_ps(old_rot, _mm256_mul_ps(rot_speed, speed_factor8));
+        // like fmod : subtract the full rotations rounded towards zero
+        const __m256 full_rotations = _mm256_round_ps(_mm256_div_ps(sum, full_rotation), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        __m256 new_rot = _mm256_sub_ps(sum, _mm256_mul_ps(full_rotations, full_rotation));
+        // fmod keeps the sign of the dividend, also for -360 giving -0
+        new_rot = _mm256_or_ps(_mm256_andnot_ps(sign_bit, new_rot), _mm256_and_ps(sign_bit, sum));
+
+        // only if the constant rotation is not 0
+        const __m256 rotating = _mm256_cmp_ps(_mm256_andnot_ps(sign_bit, rot_speed), tolerance, _CMP_GT_OQ);
+        _mm256_storeu_ps(rot + i, _mm256_or_ps(_mm256_and_ps(rotating, new_rot), _mm256_andnot_ps(rotating, old_rot)));
+    }
+
+    Rotate_Scalar(rot, const_rot, count8, count, speed_factor);
+}
+
+#endif
+
+/* *** *** *** *** *** *** *** Dispatch *** *** *** *** *** *** *** *** *** *** */
+
+static void Integrate_Plain(const Particle_Kernel_Arrays& particles, float fade_speed, float speed_factor)
+{
+    Integrate_Scalar(particles, 0, fade_speed, speed_factor);
+}
+
+static void Fade_Size_Plain(const Particle_Kernel_Arrays& particles)
+{
+    Fade_Size_Scalar(particles, 0);
+}
+
+static void Rotate_Plain(float* rot, const float* const_rot, unsigned int count, float speed_factor)
+{
+    Rotate_Scalar(rot, const_rot, 0, count, speed_factor);
+}
+
+struct Particle_Kernel {
+    const char* m_name;
+    void (*m_integrate)(const Particle_Kernel_Arrays& particles, float fade_speed, float speed_factor);
+    void (*m_fade_size)(const Particle_Kernel_Arrays& particles);
+    void (*m_rotate)(float* rot, const float* const_rot, unsigned int count, float speed_factor);
+};
+
+static Particle_Kernel Select_Particle_Kernel(void)
+{
+    Particle_Kernel kernel = {"scalar", Integrate_Plain, Fade_Size_Plain, Rotate_Plain};
+
+#ifdef TSC_PARTICLE_KERNEL_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx")) {
+        kernel.m_name = "AVX";
+        kernel.m_integrate = Integrate_AVX;
+        kernel.m_fade_size = Fade_Size_AVX;
+        kernel.m_rotate = Rotate_AVX;
+    }
+    else if (__builtin_cpu_supports("sse2")) {
+        kernel.m_name = "SSE2";
+        kernel.m_integrate = Integrate_SSE2;
+        kernel.m_fade_size = Fade_Size_SSE2;
+        kernel.m_rotate = Rotate_SSE2;
+    }
+#endif
+
+    return kernel;
+}
+
+// selected once on the first use
+static const Particle_Kernel& Get_Particle_Kernel(void)
+{
+    static const Particle_Kernel kernel = Select_Particle_Kernel();
+    return kernel;
+}
+
+void Particle_Kernel_Integrate(const Particle_Kernel_Arrays& particles, float fade_speed, float speed_factor)
+{
+    Get_Particle_Kernel().m_integrate(particles, fade_speed, speed_factor);
+}
+
+void Particle_Kernel_Fade_Size(const Particle_Kernel_Arrays& particles)
+{
+    Get_Particle_Kernel().m_fade_size(particles);
+}
+
+void Particle_Kernel_Rotate(float* rot, const float* const_rot, unsigned int count, float speed_factor)
+{
+    Get_Particle_Kernel().m_rotate(rot, const_rot, count, speed_factor);
+}
+
+const char* Particle_Kernel_Name(void)
+{
+    return Get_Particle_Kernel().m_name;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
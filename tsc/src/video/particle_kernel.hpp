@@ -0,0 +1,63 @@
+/***************************************************************************
+ * particle_kernel.hpp - Vectorized particle update loops
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_PARTICLE_KERNEL_HPP
+#define TSC_PARTICLE_KERNEL_HPP
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** Particle kernel *** *** *** *** *** *** *** *** *** *** */
+
+    /* The loops of cParticle_Emitter::Update_Particles
+     * They use AVX for 8 or SSE2 for 4 particles per iteration on x86 if the CPU
+     * supports it, the remaining particles and other CPUs use the plain loop.
+     * The implementation is selected on the first call.
+     * Only plain arrays are used so the kernel does not depend on the game headers.
+    */
+
+    // The particle arrays of an emitter the kernel works on
+    struct Particle_Kernel_Arrays {
+        float* m_pos_x;
+        float* m_pos_y;
+        float* m_vel_x;
+        float* m_vel_y;
+        const float* m_gravity_x;
+        const float* m_gravity_y;
+        float* m_scale;
+        const float* m_start_scale;
+        float* m_fade_pos;
+        const float* m_time_to_live;
+        // particles in every array
+        unsigned int m_count;
+    };
+
+    // Subtract the fade, move and accelerate every particle
+    void Particle_Kernel_Integrate(const Particle_Kernel_Arrays& particles, float fade_speed, float speed_factor);
+    // Set the scale from the start scale and the fade of every particle still fading
+    void Particle_Kernel_Fade_Size(const Particle_Kernel_Arrays& particles);
+    /* Add the constant rotation multiplied with the speed factor
+     * and keep the rotation in the 0 - 360 range like cSprite
+     * a constant rotation of 0 leaves the rotation untouched
+    */
+    void Particle_Kernel_Rotate(float* rot, const float* const_rot, unsigned int count, float speed_factor);
+
+    // Return the name of the used instruction set
+    const char* Particle_Kernel_Name(void);
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
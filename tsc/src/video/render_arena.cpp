@@ -0,0 +1,155 @@
+/***************************************************************************
+ * render_arena.cpp - Linear memory blocks for short-lived render requests
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/render_arena.hpp"
+
+using namespace std;
+
+namespace TSC {
+
+// alignment of every allocation, same as the heap guarantees on common platforms
+static const size_t arena_alignment = 16;
+// space before every allocation holding its block
+static const size_t arena_header_size = arena_alignment;
+
+static inline size_t Arena_Align(size_t size)
+{
+    return (size + arena_alignment - 1) & ~(arena_alignment - 1);
+}
+
+/* *** *** *** *** *** *** cRender_Arena *** *** *** *** *** *** *** *** *** *** *** */
+
+const size_t cRender_Arena::m_block_size = 64 * 1024;
+
+cRender_Arena::cRender_Arena(void)
+{
+    m_current = NULL;
+    m_locking = 0;
+}
+
+cRender_Arena::~cRender_Arena(void)
+{
+    for (vector<Block*>::iterator itr = m_blocks.begin(); itr != m_blocks.end(); ++itr) {
+        free(*itr);
+    }
+
+    m_blocks.clear();
+    m_free_blocks.clear();
+    m_current = NULL;
+}
+
+void* cRender_Arena::Allocate(size_t size)
+{
+    const size_t data_start = Arena_Align(sizeof(Block));
+    const size_t full_size = arena_header_size + Arena_Align(size);
+
+    // too big for a block
+    if (full_size > m_block_size - data_start) {
+        char* mem = static_cast<char*>(malloc(arena_header_size + size));
+
+        if (!mem) {
+            throw std::bad_alloc();
+        }
+
+        *reinterpret_cast<Block**>(mem) = NULL;
+        return mem + arena_header_size;
+    }
+
+    // only needed if the render thread frees
+    boost::mutex::scoped_lock lock(m_mutex, boost::defer_lock);
+
+    if (m_locking) {
+        lock.lock();
+    }
+
+    if (!m_current || m_current->m_used + full_size > m_block_size) {
+        // nothing alive in it anymore
+        if (m_current && !m_current->m_live) {
+            m_current->m_used = data_start;
+        }
+        // the old block is given back when its last allocation is freed
+        else {
+            m_current = Get_Free_Block();
+        }
+    }
+
+    char* mem = reinterpret_cast<char*>(m_current) + m_current->m_used;
+    *reinterpret_cast<Block**>(mem) = m_current;
+
+    m_current->m_used += full_size;
+    m_current->m_live++;
+
+    return mem + arena_header_size;
+}
+
+void cRender_Arena::Free(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    char* mem = static_cast<char*>(ptr) - arena_header_size;
+    Block* block = *reinterpret_cast<Block**>(mem);
+
+    // from the heap
+    if (!block) {
+        free(mem);
+        return;
+    }
+
+    boost::mutex::scoped_lock lock(m_mutex, boost::defer_lock);
+
+    if (m_locking) {
+        lock.lock();
+    }
+
+    block->m_live--;
+
+    if (block->m_live) {
+        return;
+    }
+
+    // start from the beginning again
+    block->m_used = Arena_Align(sizeof(Block));
+
+    if (block != m_current) {
+        m_free_blocks.push_back(block);
+    }
+}
+
+cRender_Arena::Block* cRender_Arena::Get_Free_Block(void)
+{
+    if (!m_free_blocks.empty()) {
+        Block* block = m_free_blocks.back();
+        m_free_blocks.pop_back();
+        return block;
+    }
+
+    Block* block = static_cast<Block*>(malloc(m_block_size));
+
+    if (!block) {
+        throw std::bad_alloc();
+    }
+
+    block->m_used = Arena_Align(sizeof(Block));
+    block->m_live = 0;
+    m_blocks.push_back(block);
+
+    return block;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,79 @@
+/***************************************************************************
+ * render_arena.hpp - Linear memory blocks for short-lived render requests
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_RENDER_ARENA_HPP
+#define TSC_RENDER_ARENA_HPP
+
+#include "../core/global_basic.hpp"
+#include <boost/thread/mutex.hpp>
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** cRender_Arena *** *** *** *** *** *** *** *** *** *** */
+
+    /* Hands out memory by moving forward in large blocks.
+     * Each block counts its allocations that are still alive and starts
+     * again from the beginning as soon as the last one is freed. Memory
+     * that lives for a frame or two, like render requests, thus never
+     * reaches the heap after the first frames, and freeing is O(1).
+     * Allocations too big for a block use the heap.
+     * Freeing may happen from another thread than allocating if locking
+     * is enabled, which must only be changed while no other thread uses it.
+     */
+    class cRender_Arena {
+    public:
+        cRender_Arena(void);
+        ~cRender_Arena(void);
+
+        // Return memory for the given size aligned like the heap
+        void* Allocate(size_t size);
+        // Free memory returned by Allocate()
+        void Free(void* ptr);
+        // Set if the mutex is used
+        inline void Set_Locking(bool enable)
+        {
+            m_locking = enable;
+        }
+
+        // bytes per block
+        static const size_t m_block_size;
+
+    private:
+        struct Block {
+            // bytes used from the start
+            size_t m_used;
+            // allocations not freed yet
+            unsigned int m_live;
+        };
+
+        // Return a reset block from the unused ones or a new one
+        Block* Get_Free_Block(void);
+
+        boost::mutex m_mutex;
+        // if another thread can free
+        bool m_locking;
+        // block allocated from
+        Block* m_current;
+        // blocks without live allocations
+        vector<Block*> m_free_blocks;
+        // every block for deletion
+        vector<Block*> m_blocks;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -0,0 +1,132 @@
+/***************************************************************************
+ * render_thread.cpp - Renders the finished frame while the next one is built
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/render_thread.hpp"
+#include "../video/renderer.hpp"
+
+namespace TSC {
+
+/* *** *** *** *** *** *** cRender_Thread *** *** *** *** *** *** *** *** *** *** *** */
+
+cRender_Thread::cRender_Thread(void)
+    : m_queue(NULL), m_busy(0)
+{
+    m_thread = NULL;
+    m_window = NULL;
+    m_quit = 0;
+}
+
+cRender_Thread::~cRender_Thread(void)
+{
+    Stop();
+}
+
+void cRender_Thread::Start(void)
+{
+    if (m_thread) {
+        return;
+    }
+
+    m_quit = 0;
+    // the thread deletes the requests it rendered
+    cRender_Request::Set_Threaded_Memory(1);
+    m_thread = new boost::thread(&cRender_Thread::Run, this);
+
+    debug_print("Render thread started\n");
+}
+
+void cRender_Thread::Stop(void)
+{
+    if (!m_thread) {
+        return;
+    }
+
+    Wait();
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_quit = 1;
+    }
+
+    m_submit_cond.notify_one();
+    m_thread->join();
+    delete m_thread;
+    m_thread = NULL;
+    cRender_Request::Set_Threaded_Memory(0);
+
+    debug_print("Render thread stopped\n");
+}
+
+void cRender_Thread::Submit(cRenderQueue* queue, sf::Window* window)
+{
+    m_window = window;
+    m_busy.store(1, std::memory_order_release);
+    m_queue.store(queue, std::memory_order_release);
+
+    // the thread may be between checking the queue and sleeping
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+    }
+
+    m_submit_cond.notify_one();
+}
+
+void cRender_Thread::Wait(void)
+{
+    if (!Is_Busy()) {
+        return;
+    }
+
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    while (m_busy.load(std::memory_order_acquire)) {
+        m_done_cond.wait(lock);
+    }
+}
+
+void cRender_Thread::Run(void)
+{
+    while (1) {
+        cRenderQueue* queue = NULL;
+
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            while (!(queue = m_queue.exchange(NULL, std::memory_order_acq_rel)) && !m_quit) {
+                m_submit_cond.wait(lock);
+            }
+
+            if (!queue) {
+                return;
+            }
+        }
+
+        m_window->setActive(1);
+        queue->Render();
+        glFlush();
+        m_window->setActive(0);
+
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            m_busy.store(0, std::memory_order_release);
+        }
+
+        m_done_cond.notify_all();
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
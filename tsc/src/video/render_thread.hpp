@@ -0,0 +1,89 @@
+/***************************************************************************
+ * render_thread.hpp - Renders the finished frame while the next one is built
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_RENDER_THREAD_HPP
+#define TSC_RENDER_THREAD_HPP
+
+#include "../core/global_basic.hpp"
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <atomic>
+
+namespace TSC {
+
+    class cRenderQueue;
+
+    /* *** *** *** *** *** *** *** cRender_Thread *** *** *** *** *** *** *** *** *** *** */
+
+    /* Owns the OpenGL context while it renders a submitted render queue.
+     * The game thread hands over the finished queue of frame N and
+     * continues with frame N+1 in the other queue. The queue pointer is
+     * passed with an atomic exchange and the mutex is only used to sleep
+     * until there is work or the work is done.
+     * While busy no OpenGL function may be called from another thread.
+     */
+    class cRender_Thread {
+    public:
+        cRender_Thread(void);
+        ~cRender_Thread(void);
+
+        // Start the thread if not running
+        void Start(void);
+        // Wait for the current frame and end the thread
+        void Stop(void);
+
+        // Return true if the thread exists
+        inline bool Is_Running(void) const
+        {
+            return m_thread != NULL;
+        }
+        // Return true if a submitted queue is not rendered yet
+        inline bool Is_Busy(void) const
+        {
+            return m_busy.load(std::memory_order_acquire);
+        }
+
+        /* Render the queue into the window from the thread
+         * the context must not be current in the calling thread
+        */
+        void Submit(cRenderQueue* queue, sf::Window* window);
+        // Wait until the submitted queue is rendered
+        void Wait(void);
+
+    private:
+        // Thread function
+        void Run(void);
+
+        boost::thread* m_thread;
+        boost::mutex m_mutex;
+        // signaled if a queue was submitted or on quit
+        boost::condition_variable m_submit_cond;
+        // signaled if a queue was rendered
+        boost::condition_variable m_done_cond;
+
+        // submitted queue taken by the thread
+        std::atomic<cRenderQueue*> m_queue;
+        // set from submit until rendered
+        std::atomic<bool> m_busy;
+        // window with the context to render into
+        sf::Window* m_window;
+        bool m_quit;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
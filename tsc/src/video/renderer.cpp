@@ -16,8 +16,10 @@
 
 #include "../core/global_basic.hpp"
 #include "../video/renderer.hpp"
+#include "../video/render_arena.hpp"
 #include "../core/game_core.hpp"
 #include "../core/global_basic.hpp"
+#include "../core/math/utilities.hpp"
 
 using namespace std;
 
@@ -29,6 +31,152 @@ namespace TSC {
 
 const float doubled_pi = static_cast<float>(M_PI * 2.0f);
 static GLuint last_bind_texture = 0;
+// camera position of the rendered queue
+static float render_camera_x = 0.0f;
+static float render_camera_y = 0.0f;
+// memory of all render requests
+static cRender_Arena render_arena;
+
+/* *** *** *** *** *** *** Render state *** *** *** *** *** *** *** *** *** *** *** */
+
+// Set the blend factors if not the default
+static inline void Set_Blend_Func(GLenum sfactor, GLenum dfactor)
+{
+    if (sfactor != GL_SRC_ALPHA || dfactor != GL_ONE_MINUS_SRC_ALPHA) {
+        glBlendFunc(sfactor, dfactor);
+    }
+}
+
+// Reset the blend factors if not the default
+static inline void Clear_Blend_Func(GLenum sfactor, GLenum dfactor)
+{
+    if (sfactor != GL_SRC_ALPHA || dfactor != GL_ONE_MINUS_SRC_ALPHA) {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+}
+
+// Set the texture color combine if a type is given
+static inline void Set_Combine(GLint combine_type, const float* combine_color)
+{
+    if (combine_type != 0) {
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
+        glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, combine_type);
+        glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_RGB, GL_CONSTANT);
+        glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, combine_color);
+        glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE1_RGB, GL_TEXTURE);
+    }
+}
+
+// Reset the texture color combine if a type is given
+static inline void Clear_Combine(GLint combine_type)
+{
+    if (combine_type != 0) {
+        float col[3] = { 0.0f, 0.0f, 0.0f };
+        glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, col);
+        glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_MODULATE);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    }
+}
+
+// if debug build check for errors
+static inline void Check_GL_Error(void)
+{
+#ifdef _DEBUG
+    // glGetError only saves one error flag
+    GLenum error = glGetError();
+
+    if (error != GL_NO_ERROR) {
+        cerr << "RenderRequest : GL Error found : " << gluErrorString(error) << endl;
+    }
+#endif
+}
+
+// Enable the vertex arrays and point them at Render_Vertex data from the bound buffer or client memory
+static void Set_Vertex_Pointers(const GLvoid* data)
+{
+    const GLubyte* base = static_cast<const GLubyte*>(data);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(Render_Vertex), base + offsetof(Render_Vertex, m_x));
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(Render_Vertex), base + offsetof(Render_Vertex, m_u));
+    glEnableClientState(GL_COLOR_ARRAY);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Render_Vertex), base + offsetof(Render_Vertex, m_color));
+
+    // ignored by the fixed function pipeline
+    if (pVideo->m_sprite_shader.Is_Available()) {
+        const cGL_Extensions& gl_ext = pVideo->m_gl_extensions;
+
+        gl_ext.glEnableVertexAttribArray(cSprite_Shader::m_combine_attribute);
+        gl_ext.glVertexAttribPointer(cSprite_Shader::m_combine_attribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Render_Vertex), base + offsetof(Render_Vertex, m_combine));
+    }
+}
+
+// Disable the vertex arrays and unbind the vertex buffer
+static void Clear_Vertex_Pointers(void)
+{
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+
+    if (pVideo->m_sprite_shader.Is_Available()) {
+        pVideo->m_gl_extensions.glDisableVertexAttribArray(cSprite_Shader::m_combine_attribute);
+    }
+
+    if (pVideo->m_gl_extensions.Has_Vertex_Buffers()) {
+        pVideo->m_gl_extensions.glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+}
+
+/* *** *** *** *** *** *** Batch transform *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Column-major 4x4 matrix functions doing the same as the OpenGL matrix
+ * functions used by cSurface_Request::Draw() so that batched quads end up
+ * at the same positions.
+*/
+
+static inline void Matrix_Identity(float* m)
+{
+    for (unsigned int i = 0; i < 16; i++) {
+        m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+}
+
+// like glScalef
+static inline void Matrix_Scale(float* m, float x, float y, float z)
+{
+    for (unsigned int i = 0; i < 4; i++) {
+        m[i] *= x;
+        m[i + 4] *= y;
+        m[i + 8] *= z;
+    }
+}
+
+// like glTranslatef
+static inline void Matrix_Translate(float* m, float x, float y, float z)
+{
+    for (unsigned int i = 0; i < 4; i++) {
+        m[i + 12] = m[i] * x + m[i + 4] * y + m[i + 8] * z + m[i + 12];
+    }
+}
+
+// like glRotatef around a main axis ( 0 = x, 1 = y, 2 = z )
+static void Matrix_Rotate(float* m, float angle, unsigned int axis)
+{
+    const float s = static_cast<float>(sin(angle * M_PI / 180.0));
+    const float c = static_cast<float>(cos(angle * M_PI / 180.0));
+    // the two columns rotated into each other
+    const unsigned int a = ((axis + 1) % 3) * 4;
+    const unsigned int b = ((axis + 2) % 3) * 4;
+
+    for (unsigned int i = 0; i < 4; i++) {
+        const float col_a = m[a + i];
+        const float col_b = m[b + i];
+
+        m[a + i] = col_a * c + col_b * s;
+        m[b + i] = col_b * c - col_a * s;
+    }
+}
 
 /* *** *** *** *** *** *** cRender_Request *** *** *** *** *** *** *** *** *** *** *** */
 
@@ -44,6 +192,21 @@ cRender_Request::~cRender_Request(void)
 
 }
 
+void* cRender_Request::operator new (size_t size)
+{
+    return render_arena.Allocate(size);
+}
+
+void cRender_Request::operator delete (void* ptr)
+{
+    render_arena.Free(ptr);
+}
+
+void cRender_Request::Set_Threaded_Memory(bool enable)
+{
+    render_arena.Set_Locking(enable);
+}
+
 void cRender_Request::Draw(void)
 {
     // virtual
@@ -55,6 +218,7 @@ cClear_Request::cClear_Request(void)
     : cRender_Request()
 {
     m_type = REND_CLEAR;
+    m_color = black;
 }
 
 cClear_Request::~cClear_Request(void)
@@ -64,6 +228,7 @@ cClear_Request::~cClear_Request(void)
 
 void cClear_Request::Draw(void)
 {
+    glClearColor(m_color.red / 255.0f, m_color.green / 255.0f, m_color.blue / 255.0f, m_color.alpha / 255.0f);
     // clear screen
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     // clear the matrix (default position and orientation)
@@ -111,27 +276,15 @@ void cRender_Request_Advanced::Render_Basic(void)
     }
 
     // blend factor
-    if (m_blend_sfactor != GL_SRC_ALPHA || m_blend_dfactor != GL_ONE_MINUS_SRC_ALPHA) {
-        glBlendFunc(m_blend_sfactor, m_blend_dfactor);
-    }
+    Set_Blend_Func(m_blend_sfactor, m_blend_dfactor);
 }
 
 void cRender_Request_Advanced::Render_Basic_Clear(void) const
 {
     // clear blend factor
-    if (m_blend_sfactor != GL_SRC_ALPHA || m_blend_dfactor != GL_ONE_MINUS_SRC_ALPHA) {
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    }
-
-    // if debug build check for errors
-#ifdef _DEBUG
-    // glGetError only saves one error flag
-    GLenum error = glGetError();
+    Clear_Blend_Func(m_blend_sfactor, m_blend_dfactor);
 
-    if (error != GL_NO_ERROR) {
-        cerr << "RenderRequest : GL Error found : " << gluErrorString(error) << endl;
-    }
-#endif
+    Check_GL_Error();
 }
 
 void cRender_Request_Advanced::Render_Advanced(void)
@@ -148,24 +301,13 @@ void cRender_Request_Advanced::Render_Advanced(void)
     }
 
     // Color Combine
-    if (m_combine_type != 0) {
-        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
-        glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, m_combine_type);
-        glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_RGB, GL_CONSTANT);
-        glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, m_combine_color);
-        glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE1_RGB, GL_TEXTURE);
-    }
+    Set_Combine(m_combine_type, m_combine_color);
 }
 
 void cRender_Request_Advanced::Render_Advanced_Clear(void) const
 {
     // clear color modifications
-    if (m_combine_type != 0) {
-        float col[3] = { 0.0f, 0.0f, 0.0f };
-        glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, col);
-        glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_MODULATE);
-        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    }
+    Clear_Combine(m_combine_type);
 }
 
 /* *** *** *** *** *** *** cLine_Request *** *** *** *** *** *** *** *** *** *** *** */
@@ -191,7 +333,7 @@ void cLine_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        glTranslatef(-pActive_Camera->m_x, -pActive_Camera->m_y, m_pos_z);
+        glTranslatef(-render_camera_x, -render_camera_y, m_pos_z);
     }
     else {
         // only z position
@@ -278,8 +420,8 @@ void cRect_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        final_pos_x -= pActive_Camera->m_x;
-        final_pos_y -= pActive_Camera->m_y;
+        final_pos_x -= render_camera_x;
+        final_pos_y -= render_camera_y;
     }
 
     glTranslatef(final_pos_x, final_pos_y, m_pos_z);
@@ -367,7 +509,7 @@ void cGradient_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        glTranslatef(m_rect.m_x - pActive_Camera->m_x, m_rect.m_y - pActive_Camera->m_y, m_pos_z);
+        glTranslatef(m_rect.m_x - render_camera_x, m_rect.m_y - render_camera_y, m_pos_z);
     }
     // ignore camera position
     else {
@@ -433,7 +575,7 @@ void cCircle_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        glTranslatef(m_pos.m_x - pActive_Camera->m_x, m_pos.m_y - pActive_Camera->m_y, m_pos_z);
+        glTranslatef(m_pos.m_x - render_camera_x, m_pos.m_y - render_camera_y, m_pos_z);
     }
     // ignore camera position
     else {
@@ -501,6 +643,24 @@ void cCircle_Request::Draw(void)
     Render_Basic_Clear();
 }
 
+/* *** *** *** *** *** *** Render_Vertex *** *** *** *** *** *** *** *** *** *** *** */
+
+void Set_Quad_Combine(Render_Vertex* vertices, GLint combine_type, const float* combine_color)
+{
+    GLubyte combine[4] = { 0, 0, 0, cSprite_Shader::Get_Combine_Attribute(combine_type) };
+
+    // clamped like the texture environment color
+    if (combine[3]) {
+        for (unsigned int i = 0; i < 3; i++) {
+            combine[i] = static_cast<GLubyte>(Clamp(combine_color[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+
+    for (unsigned int i = 0; i < 4; i++) {
+        memcpy(vertices[i].m_combine, combine, sizeof(combine));
+    }
+}
+
 /* *** *** *** *** *** *** cSurface_Request *** *** *** *** *** *** *** *** *** *** *** */
 
 cSurface_Request::cSurface_Request(void)
@@ -508,6 +668,10 @@ cSurface_Request::cSurface_Request(void)
 {
     m_type = REND_SURFACE;
     m_texture_id = 0;
+    m_tex_left = 0.0f;
+    m_tex_top = 0.0f;
+    m_tex_right = 1.0f;
+    m_tex_bottom = 1.0f;
 
     m_pos_x = 0.0f;
     m_pos_y = 0.0f;
@@ -522,6 +686,9 @@ cSurface_Request::cSurface_Request(void)
     m_color = static_cast<uint8_t>(255);
 
     m_delete_texture = 0;
+    m_opaque = 0;
+    m_repeat_x = 0;
+    m_repeat_y = 0;
 }
 
 cSurface_Request::~cSurface_Request(void)
@@ -586,8 +753,8 @@ void cSurface_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        final_pos_x -= pActive_Camera->m_x;
-        final_pos_y -= pActive_Camera->m_y;
+        final_pos_x -= render_camera_x;
+        final_pos_y -= render_camera_y;
     }
 
     glTranslatef(final_pos_x, final_pos_y, m_pos_z);
@@ -614,25 +781,40 @@ void cSurface_Request::Draw(void)
         last_bind_texture = m_texture_id;
     }
 
-    /* vertex arrays should not be used to draw simple primitives as it
-     * does have no positive performance gain
+    if (m_repeat_x) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    }
+    if (m_repeat_y) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    }
+
+    /* only used for requests drawn outside of the render queue
+     * which batches them into a vertex buffer
     */
     // rectangle
     glBegin(GL_QUADS);
     // top left
-    glTexCoord2f(0.0f, 0.0f);
+    glTexCoord2f(m_tex_left, m_tex_top);
     glVertex2f(-half_w, -half_h);
     // top right
-    glTexCoord2f(1.0f, 0.0f);
+    glTexCoord2f(m_tex_right, m_tex_top);
     glVertex2f(half_w, -half_h);
     // bottom right
-    glTexCoord2f(1.0f, 1.0f);
+    glTexCoord2f(m_tex_right, m_tex_bottom);
     glVertex2f(half_w, half_h);
     // bottom left
-    glTexCoord2f(0.0f, 1.0f);
+    glTexCoord2f(m_tex_left, m_tex_bottom);
     glVertex2f(-half_w, half_h);
     glEnd();
 
+    // textures are created with clamping
+    if (m_repeat_x) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    }
+    if (m_repeat_y) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
     // clear color
     if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
         /* alpha is automatically 1 for glColor3f
@@ -645,84 +827,1029 @@ void cSurface_Request::Draw(void)
     Render_Basic_Clear();
 }
 
-/* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
+void cSurface_Request::Get_Quad(Render_Vertex* vertices, const Color& color, bool world_space) const
+{
+    float matrix[16];
+    Matrix_Identity(matrix);
 
-cRenderQueue::cRenderQueue(unsigned int reserve_items)
+    // global scale
+    if (!world_space && m_global_scale && (global_upscalex != 1.0f || global_upscaley != 1.0f)) {
+        Matrix_Scale(matrix, global_upscalex, global_upscaley, 1.0f);
+    }
+
+    // get half the size
+    const float half_w = m_w / 2;
+    const float half_h = m_h / 2;
+    // position
+    float final_pos_x = m_pos_x + (half_w * m_scale_x);
+    float final_pos_y = m_pos_y + (half_h * m_scale_y);
+
+    // set camera position
+    if (!world_space && !m_no_camera) {
+        final_pos_x -= render_camera_x;
+        final_pos_y -= render_camera_y;
+    }
+
+    Matrix_Translate(matrix, final_pos_x, final_pos_y, m_pos_z);
+
+    // scale
+    if (m_scale_x != 1.0f || m_scale_y != 1.0f || m_scale_z != 1.0f) {
+        Matrix_Scale(matrix, m_scale_x, m_scale_y, m_scale_z);
+    }
+
+    // rotation
+    if (m_rot_x != 0.0f) {
+        Matrix_Rotate(matrix, m_rot_x, 0);
+    }
+    if (m_rot_y != 0.0f) {
+        Matrix_Rotate(matrix, m_rot_y, 1);
+    }
+    if (m_rot_z != 0.0f) {
+        Matrix_Rotate(matrix, m_rot_z, 2);
+    }
+
+    // top left, top right, bottom right and bottom left
+    const float corner_x[4] = { -half_w, half_w, half_w, -half_w };
+    const float corner_y[4] = { -half_h, -half_h, half_h, half_h };
+    const float corner_u[4] = { m_tex_left, m_tex_right, m_tex_right, m_tex_left };
+    const float corner_v[4] = { m_tex_top, m_tex_top, m_tex_bottom, m_tex_bottom };
+
+    for (unsigned int i = 0; i < 4; i++) {
+        Render_Vertex& vertex = vertices[i];
+        vertex.m_x = matrix[0] * corner_x[i] + matrix[4] * corner_y[i] + matrix[12];
+        vertex.m_y = matrix[1] * corner_x[i] + matrix[5] * corner_y[i] + matrix[13];
+        vertex.m_z = matrix[2] * corner_x[i] + matrix[6] * corner_y[i] + matrix[14];
+        vertex.m_u = corner_u[i];
+        vertex.m_v = corner_v[i];
+        vertex.m_color[0] = color.red;
+        vertex.m_color[1] = color.green;
+        vertex.m_color[2] = color.blue;
+        vertex.m_color[3] = color.alpha;
+    }
+
+    Set_Quad_Combine(vertices, m_combine_type, m_combine_color);
+}
+
+void cSurface_Request::Get_Shadow_Quad(Render_Vertex* vertices, float* combine_color, bool world_space)
 {
-    m_render_data.reserve(reserve_items);
+    // shadow as a white texture, same data changes as Draw()
+    m_pos_x += m_shadow_pos;
+    m_pos_y += m_shadow_pos;
+    m_pos_z -= 0.000001f;
+
+    Color shadow_color = black;
+    // keep m_shadow_color alpha
+    shadow_color.alpha = m_shadow_color.alpha;
+
+    combine_color[0] = static_cast<float>(m_shadow_color.red) / 260;
+    combine_color[1] = static_cast<float>(m_shadow_color.green) / 260;
+    combine_color[2] = static_cast<float>(m_shadow_color.blue) / 260;
+
+    Get_Quad(vertices, shadow_color, world_space);
+    Set_Quad_Combine(vertices, GL_REPLACE, combine_color);
+
+    m_pos_z += 0.000001f;
+    // move back to original position
+    m_pos_x -= m_shadow_pos;
+    m_pos_y -= m_shadow_pos;
 }
 
-cRenderQueue::~cRenderQueue(void)
+/* *** *** *** *** *** *** cVertex_Buffer_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+cVertex_Buffer_Request::cVertex_Buffer_Request(void)
+    : cRender_Request_Advanced()
 {
-    Clear();
+    m_type = REND_VERTEX_BUFFER;
+    m_no_camera = 0;
+
+    m_vertex_buffer = 0;
+    m_vertex_buffer_context = 0;
+    m_texture_id = 0;
+    m_first = 0;
+    m_count = 0;
+    m_opaque = 0;
 }
 
-void cRenderQueue::Add(cRender_Request* obj)
+cVertex_Buffer_Request::~cVertex_Buffer_Request(void)
 {
-    if (!obj) {
+
+}
+
+void cVertex_Buffer_Request::Draw(void)
+{
+    const cGL_Extensions& gl_ext = pVideo->m_gl_extensions;
+
+    // the buffer was deleted with its context
+    if (!m_vertex_buffer || !m_count || m_vertex_buffer_context != gl_ext.m_context_num) {
         return;
     }
 
-    // if no type
-    if (obj->m_type == REND_NOTHING) {
-        delete obj;
-        return;
+    Render_Basic();
+
+    // set camera position
+    if (!m_no_camera) {
+        glTranslatef(-render_camera_x, -render_camera_y, 0.0f);
     }
-    else {
-        // Add to render queue
-        m_render_data.push_back(obj);
+
+    Render_Advanced();
+
+    if (!glIsEnabled(GL_TEXTURE_2D)) {
+        glEnable(GL_TEXTURE_2D);
     }
+
+    // only bind if not the same texture
+    if (last_bind_texture != m_texture_id) {
+        glBindTexture(GL_TEXTURE_2D, m_texture_id);
+        last_bind_texture = m_texture_id;
+    }
+
+    gl_ext.glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+    // offsets into the buffer
+    Set_Vertex_Pointers(NULL);
+
+    glDrawArrays(GL_QUADS, m_first, m_count);
+
+    Clear_Vertex_Pointers();
+    // the current color is undefined after drawing with a color array
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+    Render_Advanced_Clear();
+    Render_Basic_Clear();
 }
 
-/**
- * Executes all render requests collected via Add().
- */
-void cRenderQueue::Render(bool clear /* = 1 */)
+/* *** *** *** *** *** *** cParticle_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+cParticle_Request::cParticle_Request(void)
+    : cRender_Request_Advanced()
 {
-    // z position sort
-    std::sort(m_render_data.begin(), m_render_data.end(), zpos_sort());
-    // reset last texture
-    last_bind_texture = 0;
+    m_type = REND_PARTICLES;
+    m_no_camera = 0;
 
-    for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
-        cRender_Request* obj = (*itr);
+    m_texture_id = 0;
+    m_tex_left = 0.0f;
+    m_tex_top = 0.0f;
+    m_tex_right = 1.0f;
+    m_tex_bottom = 1.0f;
 
-        obj->Draw();
-        obj->m_render_count--;
-    }
+    m_w = 0.0f;
+    m_h = 0.0f;
+}
+
+cParticle_Request::~cParticle_Request(void)
+{
 
-    if (clear) {
-        Clear(0);
-    }
 }
 
-void cRenderQueue::Fake_Render(unsigned int amount /* = 1 */, bool clear /* = 1 */)
+void cParticle_Request::Draw(void)
 {
-    for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
-        cRender_Request* obj = (*itr);
-        obj->m_render_count -= amount;
+    if (m_instances.empty()) {
+        return;
     }
 
-    if (clear) {
-        Clear(0);
+    /* only used for requests drawn outside of the render queue
+     * which adds the quads to its own vertex buffer
+    */
+    vector<Render_Vertex> vertices(m_instances.size() * 4);
+    Get_Quads(&vertices[0], 1);
+
+    Render_Basic();
+
+    // set camera position
+    if (!m_no_camera) {
+        glTranslatef(-render_camera_x, -render_camera_y, 0.0f);
     }
+
+    Render_Advanced();
+
+    if (!glIsEnabled(GL_TEXTURE_2D)) {
+        glEnable(GL_TEXTURE_2D);
+    }
+
+    // only bind if not the same texture
+    if (last_bind_texture != m_texture_id) {
+        glBindTexture(GL_TEXTURE_2D, m_texture_id);
+        last_bind_texture = m_texture_id;
+    }
+
+    // client side vertex array
+    if (pVideo->m_gl_extensions.Has_Vertex_Buffers()) {
+        pVideo->m_gl_extensions.glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    Set_Vertex_Pointers(&vertices[0]);
+
+    glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(vertices.size()));
+
+    Clear_Vertex_Pointers();
+    // the current color is undefined after drawing with a color array
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+    Render_Advanced_Clear();
+    Render_Basic_Clear();
 }
 
-void cRenderQueue::Clear(bool force /* = 1 */)
+void cParticle_Request::Sort_Instances(void)
 {
-    for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end();) {
-        cRender_Request* obj = (*itr);
+    // same z positions stay in the emitted order like in the render queue
+    std::stable_sort(m_instances.begin(), m_instances.end(), particle_instance_sort());
+}
 
-        // if forced or finished rendering
-        if (force || obj->m_render_count <= 0) {
-            itr = m_render_data.erase(itr);
-            delete obj;
-        }
-        // increment
-        else {
-            ++itr;
-        }
+void cParticle_Request::Get_Quads(Render_Vertex* vertices, bool world_space) const
+{
+    float scale_x = 1.0f;
+    float scale_y = 1.0f;
+
+    // global scale
+    if (!world_space && m_global_scale) {
+        scale_x = global_upscalex;
+        scale_y = global_upscaley;
     }
+
+    float camera_x = 0.0f;
+    float camera_y = 0.0f;
+
+    // set camera position
+    if (!world_space && !m_no_camera) {
+        camera_x = render_camera_x;
+        camera_y = render_camera_y;
+    }
+
+    // get half the size
+    const float half_w = m_w / 2;
+    const float half_h = m_h / 2;
+
+    // top left, top right, bottom right and bottom left
+    const float corner_x[4] = { -half_w, half_w, half_w, -half_w };
+    const float corner_y[4] = { -half_h, -half_h, half_h, half_h };
+    const float corner_u[4] = { m_tex_left, m_tex_right, m_tex_right, m_tex_left };
+    const float corner_v[4] = { m_tex_top, m_tex_top, m_tex_bottom, m_tex_bottom };
+
+    for (vector<Particle_Instance>::const_iterator itr = m_instances.begin(); itr != m_instances.end(); ++itr) {
+        const Particle_Instance& instance = *itr;
+        // position
+        const float final_pos_x = instance.m_pos_x + (half_w * instance.m_scale) - camera_x;
+        const float final_pos_y = instance.m_pos_y + (half_h * instance.m_scale) - camera_y;
+
+        // most particles only rotate in the screen plane
+        if (instance.m_rot_x == 0.0f && instance.m_rot_y == 0.0f) {
+            float s = 0.0f;
+            float c = 1.0f;
+
+            if (instance.m_rot_z != 0.0f) {
+                s = static_cast<float>(sin(instance.m_rot_z * M_PI / 180.0));
+                c = static_cast<float>(cos(instance.m_rot_z * M_PI / 180.0));
+            }
+
+            // rotated and scaled axes of the quad
+            const float axis_x[2] = { scale_x * instance.m_scale * c, scale_y * instance.m_scale * s };
+            const float axis_y[2] = { scale_x * instance.m_scale * -s, scale_y * instance.m_scale * c };
+
+            for (unsigned int i = 0; i < 4; i++) {
+                Render_Vertex& vertex = vertices[i];
+                vertex.m_x = axis_x[0] * corner_x[i] + axis_y[0] * corner_y[i] + scale_x * final_pos_x;
+                vertex.m_y = axis_x[1] * corner_x[i] + axis_y[1] * corner_y[i] + scale_y * final_pos_y;
+                vertex.m_z = instance.m_pos_z;
+            }
+        }
+        // the same as cSurface_Request::Get_Quad()
+        else {
+            float matrix[16];
+            Matrix_Identity(matrix);
+            Matrix_Scale(matrix, scale_x, scale_y, 1.0f);
+            Matrix_Translate(matrix, final_pos_x, final_pos_y, instance.m_pos_z);
+            Matrix_Scale(matrix, instance.m_scale, instance.m_scale, 1.0f);
+
+            if (instance.m_rot_x != 0.0f) {
+                Matrix_Rotate(matrix, instance.m_rot_x, 0);
+            }
+            if (instance.m_rot_y != 0.0f) {
+                Matrix_Rotate(matrix, instance.m_rot_y, 1);
+            }
+            if (instance.m_rot_z != 0.0f) {
+                Matrix_Rotate(matrix, instance.m_rot_z, 2);
+            }
+
+            for (unsigned int i = 0; i < 4; i++) {
+                Render_Vertex& vertex = vertices[i];
+                vertex.m_x = matrix[0] * corner_x[i] + matrix[4] * corner_y[i] + matrix[12];
+                vertex.m_y = matrix[1] * corner_x[i] + matrix[5] * corner_y[i] + matrix[13];
+                vertex.m_z = matrix[2] * corner_x[i] + matrix[6] * corner_y[i] + matrix[14];
+            }
+        }
+
+        for (unsigned int i = 0; i < 4; i++) {
+            Render_Vertex& vertex = vertices[i];
+            vertex.m_u = corner_u[i];
+            vertex.m_v = corner_v[i];
+            vertex.m_color[0] = instance.m_color.red;
+            vertex.m_color[1] = instance.m_color.green;
+            vertex.m_color[2] = instance.m_color.blue;
+            vertex.m_color[3] = instance.m_color.alpha;
+        }
+
+        Set_Quad_Combine(vertices, m_combine_type, m_combine_color);
+        vertices += 4;
+    }
+}
+
+/* *** *** *** *** *** *** cTexture_Upload_Command *** *** *** *** *** *** *** *** *** *** *** */
+
+cTexture_Upload_Command::cTexture_Upload_Command(GLuint texture_id, unsigned int width, unsigned int height, sf::Image* p_sf_image, bool mipmap)
+{
+    m_texture_id = texture_id;
+    m_width = width;
+    m_height = height;
+    mp_sf_image = p_sf_image;
+    m_mipmap = mipmap;
+}
+
+cTexture_Upload_Command::~cTexture_Upload_Command(void)
+{
+    delete mp_sf_image;
+}
+
+void cTexture_Upload_Command::Execute(void)
+{
+    pVideo->Upload_Texture(m_texture_id, m_width, m_height, mp_sf_image->getPixelsPtr(), m_mipmap);
+
+    // not needed anymore
+    delete mp_sf_image;
+    mp_sf_image = NULL;
+}
+
+/* *** *** *** *** *** *** cBuffer_Data_Command *** *** *** *** *** *** *** *** *** *** *** */
+
+cBuffer_Data_Command::cBuffer_Data_Command(GLuint buffer, const void* data, size_t size, GLenum usage)
+    : m_data(static_cast<const unsigned char*>(data), static_cast<const unsigned char*>(data) + size)
+{
+    m_buffer = buffer;
+    m_usage = usage;
+}
+
+cBuffer_Data_Command::~cBuffer_Data_Command(void)
+{
+
+}
+
+void cBuffer_Data_Command::Execute(void)
+{
+    pVideo->Set_Buffer_Data(m_buffer, m_data.empty() ? NULL : &m_data[0], m_data.size(), m_usage);
+}
+
+/* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
+
+cRenderQueue::cRenderQueue(unsigned int reserve_items)
+{
+    m_render_data.reserve(reserve_items);
+    m_draw_calls = 0;
+    m_opaque_draw_calls = 0;
+    m_vertices.reserve(reserve_items * 4);
+    m_batches.reserve(reserve_items);
+    m_vertex_buffer = 0;
+    m_vertex_buffer_context = 0;
+    m_use_shader = 0;
+    m_camera_x = 0.0f;
+    m_camera_y = 0.0f;
+    m_camera_stored = 0;
+}
+
+cRenderQueue::~cRenderQueue(void)
+{
+    Clear();
+
+    for (vector<cRender_Command*>::iterator itr = m_commands.begin(); itr != m_commands.end(); ++itr) {
+        delete *itr;
+    }
+
+    m_commands.clear();
+
+    // only delete if the context it was created in still exists
+    if (m_vertex_buffer && pVideo && m_vertex_buffer_context == pVideo->m_gl_extensions.m_context_num) {
+        pVideo->m_gl_extensions.glDeleteBuffers(1, &m_vertex_buffer);
+    }
+}
+
+void cRenderQueue::Add(cRender_Request* obj)
+{
+    if (!obj) {
+        return;
+    }
+
+    // if no type
+    if (obj->m_type == REND_NOTHING) {
+        delete obj;
+        return;
+    }
+    else {
+        // Add to render queue
+        m_render_data.push_back(obj);
+    }
+}
+
+void cRenderQueue::Add_Command(cRender_Command* command)
+{
+    if (!command) {
+        return;
+    }
+
+    m_commands.push_back(command);
+}
+
+void cRenderQueue::Store_Camera(void)
+{
+    if (pActive_Camera) {
+        m_camera_x = pActive_Camera->m_x;
+        m_camera_y = pActive_Camera->m_y;
+    }
+
+    m_camera_stored = 1;
+}
+
+void cRenderQueue::Run_Commands(void)
+{
+    if (m_commands.empty()) {
+        return;
+    }
+
+    for (vector<cRender_Command*>::iterator itr = m_commands.begin(); itr != m_commands.end(); ++itr) {
+        (*itr)->Execute();
+        delete *itr;
+    }
+
+    m_commands.clear();
+    // uploads change the bound texture
+    last_bind_texture = 0;
+}
+
+void cRenderQueue::Delete_Unused(void)
+{
+    if (!m_delete_textures.empty()) {
+        glDeleteTextures(static_cast<GLsizei>(m_delete_textures.size()), &m_delete_textures[0]);
+        m_delete_textures.clear();
+    }
+
+    if (!m_delete_buffers.empty()) {
+        pVideo->m_gl_extensions.glDeleteBuffers(static_cast<GLsizei>(m_delete_buffers.size()), &m_delete_buffers[0]);
+        m_delete_buffers.clear();
+    }
+}
+
+/**
+ * Executes all render requests collected via Add().
+ *
+ * Surface requests are not drawn one by one but their quads are
+ * transformed on the CPU and uploaded into one vertex buffer. Consecutive
+ * quads with the same texture, blending and color combine state are then
+ * drawn with a single call. With the sprite shader the color combine state
+ * is a vertex attribute and does not split batches, so a text and its
+ * shadow are drawn together. The particles of an emitter come as one request
+ * whose quads are expanded the same way into one batch. All other requests
+ * draw themselves in between
+ * so the z order stays the same.
+ * Between screen clears the opaque requests are drawn front to back
+ * before all others, see Add_Requests().
+ */
+void cRenderQueue::Render(bool clear /* = 1 */)
+{
+    if (!m_camera_stored) {
+        Store_Camera();
+    }
+
+    render_camera_x = m_camera_x;
+    render_camera_y = m_camera_y;
+    m_camera_stored = 0;
+
+    // sort and batch like for drawing but without OpenGL
+    if (game_headless) {
+        Add_Batches();
+        m_draw_calls = m_batches.size();
+        m_opaque_draw_calls = 0;
+
+        for (vector<Render_Batch>::const_iterator itr = m_batches.begin(); itr != m_batches.end(); ++itr) {
+            if (itr->m_opaque) {
+                m_opaque_draw_calls++;
+            }
+        }
+
+        if (clear) {
+            Clear(0);
+        }
+        return;
+    }
+
+    Run_Commands();
+    Add_Batches();
+    // reset last texture
+    last_bind_texture = 0;
+
+    m_draw_calls = 0;
+    m_opaque_draw_calls = 0;
+
+    if (!m_vertices.empty()) {
+        Upload_Vertices();
+    }
+
+    // if the vertex array pointers are set to m_vertices
+    bool vertices_bound = 0;
+    // if the sprite shader is used
+    bool shader_bound = 0;
+    // if the depth function for the opaque pass is set
+    bool opaque_depth = 0;
+
+    for (vector<Render_Batch>::const_iterator itr = m_batches.begin(); itr != m_batches.end(); ++itr) {
+        /* the opaque pass is drawn in reverse order
+         * so on the same depth the first drawn must stay
+        */
+        if (itr->m_opaque != opaque_depth) {
+            glDepthFunc(itr->m_opaque ? GL_LESS : GL_LEQUAL);
+            opaque_depth = itr->m_opaque;
+        }
+
+        if (itr->m_count) {
+            if (!vertices_bound) {
+                Bind_Vertices();
+                vertices_bound = 1;
+            }
+            if (m_use_shader && !shader_bound) {
+                pVideo->m_sprite_shader.Bind();
+                shader_bound = 1;
+            }
+
+            Draw_Batch(*itr);
+        }
+        else {
+            // other requests use the fixed function pipeline
+            if (shader_bound) {
+                pVideo->m_sprite_shader.Unbind();
+                shader_bound = 0;
+            }
+
+            itr->m_request->Draw();
+
+            // uses its own vertex buffer
+            if (itr->m_request->m_type == REND_VERTEX_BUFFER) {
+                vertices_bound = 0;
+            }
+        }
+
+        m_draw_calls++;
+
+        if (itr->m_opaque) {
+            m_opaque_draw_calls++;
+        }
+    }
+
+    if (shader_bound) {
+        pVideo->m_sprite_shader.Unbind();
+    }
+
+    if (opaque_depth) {
+        glDepthFunc(GL_LEQUAL);
+    }
+
+    if (vertices_bound) {
+        Clear_Vertex_Pointers();
+        Check_GL_Error();
+    }
+
+    Delete_Unused();
+
+    if (clear) {
+        Clear(0);
+    }
+}
+
+void cRenderQueue::Add_Batches(void)
+{
+    // z position sort
+    Sort();
+
+    m_vertices.clear();
+    m_batches.clear();
+    m_use_shader = pVideo->m_sprite_shader.Is_Available();
+
+    // start of the requests after the last screen clear
+    size_t start = 0;
+
+    for (size_t i = 0; i < m_render_data.size(); i++) {
+        cRender_Request* obj = m_render_data[i];
+
+        // nothing is drawn before a clear
+        if (obj->m_type == REND_CLEAR) {
+            Add_Requests(start, i);
+            Add_Request(obj, 0);
+            start = i + 1;
+        }
+
+        obj->m_render_count--;
+    }
+
+    Add_Requests(start, m_render_data.size());
+}
+
+uint64_t cRenderQueue::Get_Sort_Key(const cRender_Request* obj)
+{
+    // float bits in an order where negative values come first
+    uint32_t z_bits;
+    memcpy(&z_bits, &obj->m_pos_z, sizeof(z_bits));
+    z_bits = (z_bits & 0x80000000) ? ~z_bits : (z_bits | 0x80000000);
+
+    uint32_t state = 0;
+
+    const cRender_Request_Advanced* advanced = NULL;
+    GLuint texture_id = 0;
+
+    if (obj->m_type == REND_SURFACE) {
+        advanced = static_cast<const cSurface_Request*>(obj);
+        texture_id = static_cast<const cSurface_Request*>(obj)->m_texture_id;
+    }
+    else if (obj->m_type == REND_PARTICLES) {
+        advanced = static_cast<const cParticle_Request*>(obj);
+        texture_id = static_cast<const cParticle_Request*>(obj)->m_texture_id;
+    }
+
+    if (advanced) {
+        // texture first, changing it costs the most
+        state = (texture_id & 0xFFFFFF) << 8;
+
+        if (advanced->m_blend_sfactor != GL_SRC_ALPHA || advanced->m_blend_dfactor != GL_ONE_MINUS_SRC_ALPHA) {
+            state |= 0x80 | ((advanced->m_blend_sfactor ^ advanced->m_blend_dfactor) & 0x3F);
+        }
+        if (advanced->m_combine_type != 0) {
+            state |= 0x40;
+        }
+    }
+
+    return (static_cast<uint64_t>(z_bits) << 32) | state;
+}
+
+void cRenderQueue::Sort(void)
+{
+    const size_t count = m_render_data.size();
+
+    if (count < 2) {
+        return;
+    }
+
+    m_sort_entries.resize(count);
+    m_sort_temp.resize(count);
+
+    // count all 8 digits of 8 bits in one pass
+    size_t digit_count[8][256];
+    memset(digit_count, 0, sizeof(digit_count));
+
+    for (size_t i = 0; i < count; i++) {
+        Sort_Entry& entry = m_sort_entries[i];
+        entry.m_request = m_render_data[i];
+        entry.m_key = Get_Sort_Key(entry.m_request);
+
+        for (unsigned int digit = 0; digit < 8; digit++) {
+            digit_count[digit][(entry.m_key >> (digit * 8)) & 0xFF]++;
+        }
+    }
+
+    Sort_Entry* src = &m_sort_entries[0];
+    Sort_Entry* dest = &m_sort_temp[0];
+
+    for (unsigned int digit = 0; digit < 8; digit++) {
+        size_t* counts = digit_count[digit];
+        const unsigned int shift = digit * 8;
+
+        // skip if all keys have the same digit
+        if (counts[(src[0].m_key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        // start positions
+        size_t pos = 0;
+
+        for (unsigned int i = 0; i < 256; i++) {
+            const size_t digit_entries = counts[i];
+            counts[i] = pos;
+            pos += digit_entries;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            dest[counts[(src[i].m_key >> shift) & 0xFF]++] = src[i];
+        }
+
+        std::swap(src, dest);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        m_render_data[i] = src[i].m_request;
+    }
+
+#ifdef _DEBUG
+    // must be in the same order as the legacy comparator sort
+    for (size_t i = 1; i < count; i++) {
+        if (zpos_sort()(m_render_data[i], m_render_data[i - 1])) {
+            cerr << "Warning : cRenderQueue : radix sort order differs from z position sort at " << i << endl;
+            break;
+        }
+    }
+#endif
+}
+
+bool cRenderQueue::Is_Opaque(const cRender_Request* obj)
+{
+    if (obj->m_type == REND_SURFACE) {
+        const cSurface_Request* surface = static_cast<const cSurface_Request*>(obj);
+
+        return surface->m_opaque && surface->m_color.alpha == 255 &&
+               surface->m_blend_sfactor == GL_SRC_ALPHA && surface->m_blend_dfactor == GL_ONE_MINUS_SRC_ALPHA;
+    }
+    else if (obj->m_type == REND_VERTEX_BUFFER) {
+        const cVertex_Buffer_Request* buffer = static_cast<const cVertex_Buffer_Request*>(obj);
+
+        return buffer->m_opaque && buffer->m_blend_sfactor == GL_SRC_ALPHA && buffer->m_blend_dfactor == GL_ONE_MINUS_SRC_ALPHA;
+    }
+
+    return 0;
+}
+
+/* Opaque requests hide everything behind them, so drawing them front to
+ * back first lets the depth test reject the hidden fragments of everything
+ * drawn later. The translucent requests follow back to front as before.
+ * Requests on the same depth as a translucent one are not reordered.
+ */
+void cRenderQueue::Add_Requests(size_t start, size_t end)
+{
+    if (start >= end) {
+        return;
+    }
+
+    m_opaque_flags.resize(end - start);
+
+    for (size_t i = start; i < end; i++) {
+        m_opaque_flags[i - start] = Is_Opaque(m_render_data[i]);
+    }
+
+    // requests on the same depth are next to each other
+    size_t group_start = start;
+
+    for (size_t i = start + 1; i <= end; i++) {
+        if (i < end && m_render_data[i]->m_pos_z == m_render_data[group_start]->m_pos_z) {
+            continue;
+        }
+
+        bool group_opaque = 1;
+
+        for (size_t j = group_start; j < i; j++) {
+            if (!m_opaque_flags[j - start]) {
+                group_opaque = 0;
+                break;
+            }
+        }
+
+        if (!group_opaque) {
+            for (size_t j = group_start; j < i; j++) {
+                m_opaque_flags[j - start] = 0;
+            }
+        }
+
+        group_start = i;
+    }
+
+    // opaque front to back
+    for (size_t i = end; i > start; i--) {
+        if (!m_opaque_flags[i - 1 - start]) {
+            continue;
+        }
+
+        cRender_Request* obj = m_render_data[i - 1];
+
+        if (obj->m_type == REND_SURFACE) {
+            Add_Surface(static_cast<cSurface_Request*>(obj), 0, 1, 1);
+        }
+        else {
+            Add_Request(obj, 1);
+        }
+    }
+
+    // translucent back to front
+    for (size_t i = start; i < end; i++) {
+        cRender_Request* obj = m_render_data[i];
+        const bool opaque = m_opaque_flags[i - start] != 0;
+
+        if (obj->m_type == REND_SURFACE) {
+            // the shadow of an opaque image is still translucent
+            Add_Surface(static_cast<cSurface_Request*>(obj), 1, !opaque, 0);
+        }
+        else if (obj->m_type == REND_PARTICLES) {
+            Add_Particles(static_cast<cParticle_Request*>(obj));
+        }
+        else if (!opaque) {
+            Add_Request(obj, 0);
+        }
+    }
+}
+
+void cRenderQueue::Add_Request(cRender_Request* request, bool opaque)
+{
+    Render_Batch batch;
+    batch.m_request = request;
+    batch.m_opaque = opaque;
+    batch.m_count = 0;
+    m_batches.push_back(batch);
+}
+
+void cRenderQueue::Add_Surface(cSurface_Request* request, bool shadow, bool image, bool opaque)
+{
+    Render_Vertex vertices[4];
+
+    if (shadow && request->m_shadow_pos) {
+        float shadow_combine_color[3];
+        request->Get_Shadow_Quad(vertices, shadow_combine_color, 0);
+        Add_Surface_Quad(vertices, request, GL_REPLACE, shadow_combine_color, opaque);
+    }
+
+    if (image) {
+        request->Get_Quad(vertices, request->m_color, 0);
+        Add_Surface_Quad(vertices, request, request->m_combine_type, request->m_combine_color, opaque);
+    }
+}
+
+void cRenderQueue::Add_Surface_Quad(const Render_Vertex* vertices, const cSurface_Request* request, GLint combine_type, const float* combine_color, bool opaque)
+{
+    m_vertices.insert(m_vertices.end(), vertices, vertices + 4);
+
+    Add_Batch_Vertices(4, request->m_texture_id, request->m_repeat_x, request->m_repeat_y, request->m_blend_sfactor, request->m_blend_dfactor,
+                       combine_type, combine_color, opaque);
+}
+
+void cRenderQueue::Add_Particles(const cParticle_Request* request)
+{
+    if (request->m_instances.empty()) {
+        return;
+    }
+
+    const size_t first = m_vertices.size();
+    const size_t count = request->m_instances.size() * 4;
+
+    m_vertices.resize(first + count);
+    request->Get_Quads(&m_vertices[first], 0);
+
+    Add_Batch_Vertices(static_cast<GLsizei>(count), request->m_texture_id, 0, 0, request->m_blend_sfactor, request->m_blend_dfactor,
+                       request->m_combine_type, request->m_combine_color, 0);
+}
+
+void cRenderQueue::Add_Batch_Vertices(GLsizei count, GLuint texture_id, bool repeat_x, bool repeat_y, GLenum blend_sfactor, GLenum blend_dfactor,
+                                      GLint combine_type, const float* combine_color, bool opaque)
+{
+    // continue the last batch if the state is the same
+    if (!m_batches.empty()) {
+        Render_Batch& last = m_batches.back();
+
+        // the shader takes the combine state from the vertices
+        if (last.m_count && last.m_opaque == opaque && last.m_texture_id == texture_id &&
+                last.m_repeat_x == repeat_x && last.m_repeat_y == repeat_y &&
+                last.m_blend_sfactor == blend_sfactor && last.m_blend_dfactor == blend_dfactor &&
+                (m_use_shader || (last.m_combine_type == combine_type && (combine_type == 0 ||
+                        (last.m_combine_color[0] == combine_color[0] && last.m_combine_color[1] == combine_color[1] && last.m_combine_color[2] == combine_color[2]))))) {
+            last.m_count += count;
+            return;
+        }
+    }
+
+    Render_Batch batch;
+    batch.m_request = NULL;
+    batch.m_opaque = opaque;
+    batch.m_texture_id = texture_id;
+    batch.m_repeat_x = repeat_x;
+    batch.m_repeat_y = repeat_y;
+    batch.m_blend_sfactor = blend_sfactor;
+    batch.m_blend_dfactor = blend_dfactor;
+    batch.m_combine_type = combine_type;
+    batch.m_combine_color[0] = combine_color[0];
+    batch.m_combine_color[1] = combine_color[1];
+    batch.m_combine_color[2] = combine_color[2];
+    batch.m_first = static_cast<GLint>(m_vertices.size() - count);
+    batch.m_count = count;
+
+    m_batches.push_back(batch);
+}
+
+void cRenderQueue::Upload_Vertices(void)
+{
+    const cGL_Extensions& gl_ext = pVideo->m_gl_extensions;
+
+    if (gl_ext.Has_Vertex_Buffers()) {
+        // the old buffer was deleted with its context
+        if (m_vertex_buffer_context != gl_ext.m_context_num) {
+            m_vertex_buffer = 0;
+            m_vertex_buffer_context = gl_ext.m_context_num;
+        }
+
+        if (!m_vertex_buffer) {
+            gl_ext.glGenBuffers(1, &m_vertex_buffer);
+        }
+
+        gl_ext.glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+        // a new data store every frame so the driver does not wait for the last frame
+        gl_ext.glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(Render_Vertex), &m_vertices[0], GL_STREAM_DRAW);
+    }
+    // client side vertex arrays
+    else {
+        m_vertex_buffer = 0;
+    }
+}
+
+void cRenderQueue::Bind_Vertices(void)
+{
+    if (m_vertex_buffer) {
+        pVideo->m_gl_extensions.glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+        // offsets into the buffer
+        Set_Vertex_Pointers(NULL);
+    }
+    else {
+        Set_Vertex_Pointers(&m_vertices[0]);
+    }
+}
+
+void cRenderQueue::Draw_Batch(const Render_Batch& batch)
+{
+    // the vertices are already transformed
+    glLoadIdentity();
+
+    Set_Blend_Func(batch.m_blend_sfactor, batch.m_blend_dfactor);
+    // the shader takes the combine state from the vertices
+    if (!m_use_shader) {
+        Set_Combine(batch.m_combine_type, batch.m_combine_color);
+    }
+
+    if (!glIsEnabled(GL_TEXTURE_2D)) {
+        glEnable(GL_TEXTURE_2D);
+    }
+
+    // only bind if not the same texture
+    if (last_bind_texture != batch.m_texture_id) {
+        glBindTexture(GL_TEXTURE_2D, batch.m_texture_id);
+        last_bind_texture = batch.m_texture_id;
+    }
+
+    // the wrap mode is texture state so it is only set for this draw
+    if (batch.m_repeat_x) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    }
+    if (batch.m_repeat_y) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    }
+
+    glDrawArrays(GL_QUADS, batch.m_first, batch.m_count);
+
+    // textures are created with clamping
+    if (batch.m_repeat_x) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    }
+    if (batch.m_repeat_y) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    // the current color is undefined after drawing with a color array
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+    if (!m_use_shader) {
+        Clear_Combine(batch.m_combine_type);
+    }
+
+    Clear_Blend_Func(batch.m_blend_sfactor, batch.m_blend_dfactor);
+}
+
+void cRenderQueue::Fake_Render(unsigned int amount /* = 1 */, bool clear /* = 1 */)
+{
+    Run_Commands();
+
+    for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
+        cRender_Request* obj = (*itr);
+        obj->m_render_count -= amount;
+    }
+
+    Delete_Unused();
+
+    if (clear) {
+        Clear(0);
+    }
+}
+
+void cRenderQueue::Clear(bool force /* = 1 */)
+{
+    // requests which render again are moved to the front keeping their order
+    RenderList::iterator keep_end = m_render_data.begin();
+
+    for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
+        cRender_Request* obj = (*itr);
+
+        // if forced or finished rendering
+        if (force || obj->m_render_count <= 0) {
+            delete obj;
+        }
+        else {
+            *keep_end = obj;
+            ++keep_end;
+        }
+    }
+
+    m_render_data.erase(keep_end, m_render_data.end());
 }
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
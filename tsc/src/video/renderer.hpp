@@ -33,7 +33,9 @@ namespace TSC {
         REND_SURFACE = 4,
         REND_TEXT = 5,
         REND_LINE = 6,
-        REND_CIRCLE = 7
+        REND_CIRCLE = 7,
+        REND_VERTEX_BUFFER = 8,
+        REND_PARTICLES = 9
     };
 
     /* *** *** *** *** *** *** cRender_Request *** *** *** *** *** *** *** *** *** *** *** */
@@ -43,6 +45,16 @@ namespace TSC {
         cRender_Request(void);
         virtual ~cRender_Request(void);
 
+        /* Requests are created for every drawn object each frame
+         * and are allocated from the render arena instead of the heap
+        */
+        static void* operator new (size_t size);
+        static void operator delete (void* ptr);
+        /* Set if requests can be deleted from the render thread
+         * only while the render thread is not running
+        */
+        static void Set_Threaded_Memory(bool enable);
+
         // draw
         virtual void Draw(void);
 
@@ -65,6 +77,9 @@ namespace TSC {
 
         // draw
         virtual void Draw(void);
+
+        // clear color
+        Color m_color;
     };
 
     /* *** *** *** *** *** *** cRender_Request_Advanced *** *** *** *** *** *** *** *** *** *** *** */
@@ -190,6 +205,23 @@ namespace TSC {
         float m_line_width;
     };
 
+    /* *** *** *** *** *** *** Render_Vertex *** *** *** *** *** *** *** *** *** *** *** */
+
+    // vertex of a transformed surface quad
+    struct Render_Vertex {
+        GLfloat m_x;
+        GLfloat m_y;
+        GLfloat m_z;
+        GLfloat m_u;
+        GLfloat m_v;
+        GLubyte m_color[4];
+        // combine color and type for the sprite shader
+        GLubyte m_combine[4];
+    };
+
+    // Set the combine attribute of the 4 quad vertices
+    void Set_Quad_Combine(Render_Vertex* vertices, GLint combine_type, const float* combine_color);
+
     /* *** *** *** *** *** *** cSurface_Request *** *** *** *** *** *** *** *** *** *** *** */
 
     class cSurface_Request : public cRender_Request_Advanced {
@@ -200,8 +232,25 @@ namespace TSC {
         // Draw
         virtual void Draw(void);
 
+        /* Transform the quad on the CPU into the 4 vertices with the given color
+         * and the combine state of the request
+         * top left, top right, bottom right and bottom left
+         * world_space : if set the global scale and camera position are not applied
+        */
+        void Get_Quad(Render_Vertex* vertices, const Color& color, bool world_space) const;
+        /* Transform the shadow quad into the 4 vertices and set its combine color
+         * the vertices get the GL_REPLACE combine state with this color
+         * must only be used if m_shadow_pos is set
+        */
+        void Get_Shadow_Quad(Render_Vertex* vertices, float* combine_color, bool world_space);
+
         // texture id
         GLuint m_texture_id;
+        // texture coordinates
+        float m_tex_left;
+        float m_tex_top;
+        float m_tex_right;
+        float m_tex_bottom;
         // position
         float m_pos_x;
         float m_pos_y;
@@ -218,6 +267,149 @@ namespace TSC {
 
         // delete texture after request finished
         bool m_delete_texture;
+        // if the texture has no translucent pixels
+        bool m_opaque;
+        /* repeat the texture horizontally or vertically for coordinates outside of 0 to 1
+         * the texture must not be an atlas page
+        */
+        bool m_repeat_x;
+        bool m_repeat_y;
+    };
+
+    /* *** *** *** *** *** *** cVertex_Buffer_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Draws quads from a vertex buffer which are already in level coordinates
+     * only the global scale and camera position are applied
+     * used for cached geometry which does not change every frame
+    */
+    class cVertex_Buffer_Request : public cRender_Request_Advanced {
+    public:
+        cVertex_Buffer_Request(void);
+        virtual ~cVertex_Buffer_Request(void);
+
+        // draw
+        virtual void Draw(void);
+
+        // buffer with Render_Vertex data
+        GLuint m_vertex_buffer;
+        // context the buffer belongs to
+        unsigned int m_vertex_buffer_context;
+        // texture id
+        GLuint m_texture_id;
+        // vertices drawn
+        GLint m_first;
+        GLsizei m_count;
+        // if all quads are fully opaque
+        bool m_opaque;
+    };
+
+    /* *** *** *** *** *** *** cParticle_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+    // position, scale, rotation and color of a particle quad
+    struct Particle_Instance {
+        float m_pos_x;
+        float m_pos_y;
+        float m_pos_z;
+        float m_scale;
+        float m_rot_x;
+        float m_rot_y;
+        float m_rot_z;
+        Color m_color;
+    };
+
+    struct particle_instance_sort {
+        bool operator()(const Particle_Instance& a, const Particle_Instance& b) const
+        {
+            return a.m_pos_z < b.m_pos_z;
+        }
+    };
+
+    /* All particles of an emitter with the same image and blending
+     * The render queue sorts it with its z position as one request and
+     * expands the instances into one batch of quads drawn with a single call.
+     * The quads keep the z position of their instance for the depth test.
+    */
+    class cParticle_Request : public cRender_Request_Advanced {
+    public:
+        cParticle_Request(void);
+        virtual ~cParticle_Request(void);
+
+        // draw
+        virtual void Draw(void);
+
+        // Add an instance and return it
+        inline Particle_Instance& Add_Instance(void)
+        {
+            m_instances.push_back(Particle_Instance());
+            return m_instances.back();
+        }
+        // Order the instances by their z position
+        void Sort_Instances(void);
+        /* Transform the quads of all instances into 4 vertices each
+         * top left, top right, bottom right and bottom left
+         * world_space : if set the global scale and camera position are not applied
+        */
+        void Get_Quads(Render_Vertex* vertices, bool world_space) const;
+
+        // texture id
+        GLuint m_texture_id;
+        // texture coordinates
+        float m_tex_left;
+        float m_tex_top;
+        float m_tex_right;
+        float m_tex_bottom;
+        // size of an unscaled quad
+        float m_w;
+        float m_h;
+
+        // instances in drawing order
+        vector<Particle_Instance> m_instances;
+    };
+
+    /* *** *** *** *** *** *** cRender_Command *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* OpenGL work requested by game code while another thread renders
+     * executed before the requests of the queue it was added to
+    */
+    class cRender_Command {
+    public:
+        virtual ~cRender_Command(void) {}
+
+        // execute with the context current
+        virtual void Execute(void) = 0;
+    };
+
+    /* *** *** *** *** *** *** cTexture_Upload_Command *** *** *** *** *** *** *** *** *** *** *** */
+
+    // Copies the image into the already generated texture and deletes the image
+    class cTexture_Upload_Command : public cRender_Command {
+    public:
+        cTexture_Upload_Command(GLuint texture_id, unsigned int width, unsigned int height, sf::Image* p_sf_image, bool mipmap);
+        virtual ~cTexture_Upload_Command(void);
+
+        virtual void Execute(void);
+
+        GLuint m_texture_id;
+        // texture size
+        unsigned int m_width;
+        unsigned int m_height;
+        sf::Image* mp_sf_image;
+        bool m_mipmap;
+    };
+
+    /* *** *** *** *** *** *** cBuffer_Data_Command *** *** *** *** *** *** *** *** *** *** *** */
+
+    // Replaces the data of a buffer object with a copy taken when created
+    class cBuffer_Data_Command : public cRender_Command {
+    public:
+        cBuffer_Data_Command(GLuint buffer, const void* data, size_t size, GLenum usage);
+        virtual ~cBuffer_Data_Command(void);
+
+        virtual void Execute(void);
+
+        GLuint m_buffer;
+        vector<unsigned char> m_data;
+        GLenum m_usage;
     };
 
     /* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
@@ -230,8 +422,18 @@ namespace TSC {
         /* Add a Render Request
         */
         void Add(cRender_Request* obj);
+        /* Add a command executed at the start of the next Render() or Fake_Render()
+         * the queue takes ownership
+        */
+        void Add_Command(cRender_Command* command);
+        /* Store the active camera position used by the next Render()
+         * needed if the game moves the camera while another thread renders
+         * if not stored the current position is used
+        */
+        void Store_Camera(void);
 
         /* Render current data
+         * in headless mode the batches are only built and nothing is drawn
          * clear: if set clear the finished data after rendering
         */
         void Render(bool clear = 1);
@@ -249,14 +451,122 @@ namespace TSC {
 
         // render data array
         RenderList m_render_data;
+        // OpenGL draw calls of the last Render()
+        uint32_t m_draw_calls;
+        // draw calls of the opaque pass in the last Render()
+        uint32_t m_opaque_draw_calls;
+        // textures and buffers deleted after the next Render() or Fake_Render()
+        vector<GLuint> m_delete_textures;
+        vector<GLuint> m_delete_buffers;
+
+        /* Return true if the request covers everything behind it
+         * and can be drawn before it
+        */
+        static bool Is_Opaque(const cRender_Request* obj);
 
-        // Z position sort
+        /* Z position sort
+         * only used to check the radix sort order in debug builds
+        */
         struct zpos_sort {
             bool operator()(const cRender_Request* a, const cRender_Request* b) const
             {
                 return a->m_pos_z < b->m_pos_z;
             }
         };
+
+    private:
+        // request with its sort key
+        struct Sort_Entry {
+            uint64_t m_key;
+            cRender_Request* m_request;
+        };
+
+        /* Return the sort key of the request
+         * the z position as order preserving bits in the high part
+         * and the texture and blending state in the low part so that
+         * requests with the same z position are grouped by state
+        */
+        static uint64_t Get_Sort_Key(const cRender_Request* obj);
+        // Sort the requests by their key with a stable LSD radix sort
+        void Sort(void);
+
+        /* Consecutive surface quads drawn with one call
+         * or a request which draws itself if the vertex count is 0
+        */
+        struct Render_Batch {
+            cRender_Request* m_request;
+            // drawn in the opaque pass
+            bool m_opaque;
+            GLuint m_texture_id;
+            // texture wrap mode is GL_REPEAT
+            bool m_repeat_x;
+            bool m_repeat_y;
+            GLenum m_blend_sfactor;
+            GLenum m_blend_dfactor;
+            GLint m_combine_type;
+            float m_combine_color[3];
+            // vertices in the buffer
+            GLint m_first;
+            GLsizei m_count;
+        };
+
+        // Execute and delete the commands
+        void Run_Commands(void);
+        // Delete the textures and buffers which are not used anymore
+        void Delete_Unused(void);
+
+        /* Sort the requests and add their batches and vertices
+         * also counts down the render count of the requests
+        */
+        void Add_Batches(void);
+        /* Add the batches of the sorted requests in the given range
+         * the opaque ones front to back and then the others back to front
+        */
+        void Add_Requests(size_t start, size_t end);
+        // Add a batch of a request which draws itself
+        void Add_Request(cRender_Request* request, bool opaque);
+        /* Add the quads of the surface request
+         * shadow : add the shadow quad
+         * image : add the image quad
+        */
+        void Add_Surface(cSurface_Request* request, bool shadow, bool image, bool opaque);
+        // Add the transformed quad of the surface request with the given color combine state
+        void Add_Surface_Quad(const Render_Vertex* vertices, const cSurface_Request* request, GLint combine_type, const float* combine_color, bool opaque);
+        // Add the quads of all particle instances
+        void Add_Particles(const cParticle_Request* request);
+        /* Add the last vertices to the batch or continue the last batch if the state is the same
+         * count : vertices already added to m_vertices
+        */
+        void Add_Batch_Vertices(GLsizei count, GLuint texture_id, bool repeat_x, bool repeat_y, GLenum blend_sfactor, GLenum blend_dfactor,
+                                GLint combine_type, const float* combine_color, bool opaque);
+        // Upload the vertices
+        void Upload_Vertices(void);
+        // Bind the vertices and set the vertex array pointers
+        void Bind_Vertices(void);
+        // Draw the quads of the batch
+        void Draw_Batch(const Render_Batch& batch);
+
+        // if the sprite shader combines the colors in this Render()
+        bool m_use_shader;
+        // commands to execute before rendering
+        vector<cRender_Command*> m_commands;
+        // camera position for the next Render()
+        float m_camera_x;
+        float m_camera_y;
+        bool m_camera_stored;
+        // sort buffers
+        vector<Sort_Entry> m_sort_entries;
+        vector<Sort_Entry> m_sort_temp;
+        // vertices of the current Render() in final screen coordinates
+        vector<Render_Vertex> m_vertices;
+        // batches of the current Render()
+        vector<Render_Batch> m_batches;
+        // opaque state of the requests in the current Add_Requests() range
+        vector<uint8_t> m_opaque_flags;
+        // vertex buffer object or 0 if not created
+        GLuint m_vertex_buffer;
+        // context the vertex buffer belongs to
+        unsigned int m_vertex_buffer_context;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
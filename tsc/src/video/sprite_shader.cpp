@@ -0,0 +1,194 @@
+/***************************************************************************
+ * sprite_shader.cpp - GLSL program for batched sprite quads
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/sprite_shader.hpp"
+#include "../video/video.hpp"
+
+using namespace std;
+
+namespace TSC {
+
+/* The combine type is stored as 0, 1, 2 or 3 in thirds of the attribute alpha
+ * which is normalized to 0.0 - 1.0
+*/
+static const char* sprite_vertex_shader =
+    "#version 120\n"
+    "attribute vec4 combine;\n"
+    "varying vec4 combine_data;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = ftransform();\n"
+    "    gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+    "    gl_FrontColor = gl_Color;\n"
+    "    combine_data = combine;\n"
+    "}\n";
+
+static const char* sprite_fragment_shader =
+    "#version 120\n"
+    "uniform sampler2D sprite_texture;\n"
+    "varying vec4 combine_data;\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 tex = texture2D(sprite_texture, gl_TexCoord[0].st);\n"
+    "    float type = floor(combine_data.a * 3.0 + 0.5);\n"
+    "    vec3 rgb;\n"
+    // like GL_MODULATE of the texture environment
+    "    if (type < 0.5) {\n"
+    "        rgb = tex.rgb * gl_Color.rgb;\n"
+    "    }\n"
+    // GL_REPLACE
+    "    else if (type < 1.5) {\n"
+    "        rgb = combine_data.rgb;\n"
+    "    }\n"
+    // GL_MODULATE
+    "    else if (type < 2.5) {\n"
+    "        rgb = combine_data.rgb * tex.rgb;\n"
+    "    }\n"
+    // GL_ADD
+    "    else {\n"
+    "        rgb = min(combine_data.rgb + tex.rgb, 1.0);\n"
+    "    }\n"
+    // the combine alpha is always the texture alpha modulated with the color alpha
+    "    gl_FragColor = vec4(rgb, tex.a * gl_Color.a);\n"
+    "}\n";
+
+/* *** *** *** *** *** *** cSprite_Shader *** *** *** *** *** *** *** *** *** *** *** */
+
+// not aliased with the fixed function attributes on any driver
+const GLuint cSprite_Shader::m_combine_attribute = 6;
+
+cSprite_Shader::cSprite_Shader(void)
+{
+    m_program = 0;
+    m_program_context = 0;
+}
+
+cSprite_Shader::~cSprite_Shader(void)
+{
+    // deleted with the context
+}
+
+void cSprite_Shader::Init(bool enabled)
+{
+    const cGL_Extensions& gl_ext = pVideo->m_gl_extensions;
+
+    Delete();
+
+    if (!enabled || !gl_ext.Has_Shaders()) {
+        return;
+    }
+
+    GLuint vertex_shader = Compile(GL_VERTEX_SHADER, sprite_vertex_shader);
+    GLuint fragment_shader = Compile(GL_FRAGMENT_SHADER, sprite_fragment_shader);
+
+    if (vertex_shader && fragment_shader) {
+        m_program = gl_ext.glCreateProgram();
+        m_program_context = gl_ext.m_context_num;
+
+        gl_ext.glAttachShader(m_program, vertex_shader);
+        gl_ext.glAttachShader(m_program, fragment_shader);
+        gl_ext.glBindAttribLocation(m_program, m_combine_attribute, "combine");
+        gl_ext.glLinkProgram(m_program);
+
+        GLint status = 0;
+        gl_ext.glGetProgramiv(m_program, GL_LINK_STATUS, &status);
+
+        if (!status) {
+            char log[1024];
+            gl_ext.glGetProgramInfoLog(m_program, sizeof(log), NULL, log);
+            cerr << "Warning : Sprite shader linking failed : " << log << endl;
+
+            gl_ext.glDeleteProgram(m_program);
+            m_program = 0;
+        }
+        else {
+            gl_ext.glUseProgram(m_program);
+            gl_ext.glUniform1i(gl_ext.glGetUniformLocation(m_program, "sprite_texture"), 0);
+            gl_ext.glUseProgram(0);
+        }
+    }
+
+    // kept alive by the program
+    if (vertex_shader) {
+        gl_ext.glDeleteShader(vertex_shader);
+    }
+    if (fragment_shader) {
+        gl_ext.glDeleteShader(fragment_shader);
+    }
+
+    debug_print("Sprite shader : %s\n", m_program ? "used" : "failed, using the fixed function pipeline");
+}
+
+void cSprite_Shader::Bind(void) const
+{
+    pVideo->m_gl_extensions.glUseProgram(m_program);
+}
+
+void cSprite_Shader::Unbind(void) const
+{
+    pVideo->m_gl_extensions.glUseProgram(0);
+}
+
+GLubyte cSprite_Shader::Get_Combine_Attribute(GLint combine_type)
+{
+    if (combine_type == GL_REPLACE) {
+        return 85;
+    }
+    else if (combine_type == GL_MODULATE) {
+        return 170;
+    }
+    else if (combine_type == GL_ADD) {
+        return 255;
+    }
+
+    return 0;
+}
+
+GLuint cSprite_Shader::Compile(GLenum type, const char* source) const
+{
+    const cGL_Extensions& gl_ext = pVideo->m_gl_extensions;
+
+    GLuint shader = gl_ext.glCreateShader(type);
+    gl_ext.glShaderSource(shader, 1, &source, NULL);
+    gl_ext.glCompileShader(shader);
+
+    GLint status = 0;
+    gl_ext.glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+
+    if (!status) {
+        char log[1024];
+        gl_ext.glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        cerr << "Warning : Sprite shader compilation failed : " << log << endl;
+
+        gl_ext.glDeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+void cSprite_Shader::Delete(void)
+{
+    // only delete if the context it was created in still exists
+    if (m_program && pVideo && m_program_context == pVideo->m_gl_extensions.m_context_num) {
+        pVideo->m_gl_extensions.glDeleteProgram(m_program);
+    }
+
+    m_program = 0;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
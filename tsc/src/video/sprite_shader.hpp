@@ -0,0 +1,74 @@
+/***************************************************************************
+ * sprite_shader.hpp - GLSL program for batched sprite quads
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_SPRITE_SHADER_HPP
+#define TSC_SPRITE_SHADER_HPP
+
+#include "../core/global_basic.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** cSprite_Shader *** *** *** *** *** *** *** *** *** *** */
+
+    /* Does the color combine of the fixed function texture environment
+     * with the combine color and type taken from a vertex attribute.
+     * Quads with different combine states, like text with its shadow,
+     * can then be drawn with one call.
+     * Only the combine types used by the game are supported :
+     * none, GL_REPLACE, GL_MODULATE and GL_ADD.
+     */
+    class cSprite_Shader {
+    public:
+        cSprite_Shader(void);
+        ~cSprite_Shader(void);
+
+        /* Compile the program for the current context
+         * does nothing if shaders are not available or disabled
+        */
+        void Init(bool enabled);
+
+        // Returns true if the program can be used
+        inline bool Is_Available(void) const
+        {
+            return m_program != 0;
+        }
+
+        // Use the program
+        void Bind(void) const;
+        // Use the fixed function pipeline again
+        void Unbind(void) const;
+
+        // Return the attribute value of the combine type
+        static GLubyte Get_Combine_Attribute(GLint combine_type);
+
+        // vertex attribute index of the combine color and type
+        static const GLuint m_combine_attribute;
+
+    private:
+        // Compile the shader and return it or 0 if failed
+        GLuint Compile(GLenum type, const char* source) const;
+        // Delete the program if its context still exists
+        void Delete(void);
+
+        GLuint m_program;
+        // context the program belongs to
+        unsigned int m_program_context;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -0,0 +1,445 @@
+/***************************************************************************
+ * static_geometry.cpp - Cached vertex buffers of non-moving level sprites
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/static_geometry.hpp"
+#include "../video/gl_surface.hpp"
+#include "../objects/sprite.hpp"
+#include "../core/game_core.hpp"
+#include "../core/camera.hpp"
+
+using namespace std;
+
+namespace TSC {
+
+// Return the chunk number of the level position
+static inline int Get_Chunk_Pos(float pos)
+{
+    return static_cast<int>(floor(pos / cStatic_Geometry::m_chunk_size));
+}
+
+// Return the map key of the chunk position
+static inline uint64_t Get_Chunk_Key(int x, int y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+/* Return the massive type z range of the position
+ * the dynamic sprites are placed between the ranges
+*/
+static inline int Get_Z_Range(float pos_z)
+{
+    if (pos_z < cSprite::m_pos_z_halfmassive_start) {
+        return 0;
+    }
+    if (pos_z < cSprite::m_pos_z_massive_start) {
+        return 1;
+    }
+    if (pos_z < cSprite::m_pos_z_front_passive_start) {
+        return 2;
+    }
+
+    return 3;
+}
+
+/* *** *** *** *** *** *** cStatic_Geometry_Chunk *** *** *** *** *** *** *** *** *** *** *** */
+
+cStatic_Geometry_Chunk::cStatic_Geometry_Chunk(int x, int y)
+{
+    m_x = x;
+    m_y = y;
+    m_vertex_buffer = 0;
+    m_vertex_buffer_context = 0;
+    m_dirty = 1;
+}
+
+cStatic_Geometry_Chunk::~cStatic_Geometry_Chunk(void)
+{
+    Delete_Buffer();
+}
+
+void cStatic_Geometry_Chunk::Delete_Buffer(void)
+{
+    // only delete if the context it was created in still exists
+    if (m_vertex_buffer && pVideo && m_vertex_buffer_context == pVideo->m_gl_extensions.m_context_num) {
+        pVideo->Delete_Buffer(m_vertex_buffer);
+    }
+
+    m_vertex_buffer = 0;
+}
+
+/* *** *** *** *** *** *** cStatic_Geometry *** *** *** *** *** *** *** *** *** *** *** */
+
+const float cStatic_Geometry::m_chunk_size = 1024.0f;
+
+cStatic_Geometry::cStatic_Geometry(void)
+{
+    m_context_num = 0;
+    m_editor_enabled = 0;
+}
+
+cStatic_Geometry::~cStatic_Geometry(void)
+{
+    Clear();
+}
+
+bool cStatic_Geometry::Is_Static(const cSprite* sprite)
+{
+    // derived types may change their image in Update()
+    if (typeid(*sprite) != typeid(cSprite)) {
+        return 0;
+    }
+
+    // front passive sprites are drawn over the player
+    if (sprite->m_massive_type != MASS_PASSIVE && sprite->m_massive_type != MASS_MASSIVE && sprite->m_massive_type != MASS_HALFMASSIVE) {
+        return 0;
+    }
+
+    // animated
+    if (sprite->m_anim_enabled && sprite->m_images.size() > 1) {
+        return 0;
+    }
+
+    return !sprite->m_no_camera;
+}
+
+void cStatic_Geometry::Add(cSprite* sprite)
+{
+    if (sprite->m_static_geometry_entry.m_chunk || !Is_Static(sprite)) {
+        return;
+    }
+
+    cSurface_Request request;
+
+    // the chunk its image is drawn in
+    if (Get_Request(sprite, request)) {
+        Insert(Get_Chunk(request.m_pos_x, request.m_pos_y), sprite);
+    }
+    else {
+        Insert(Get_Chunk(sprite->m_pos_x, sprite->m_pos_y), sprite);
+    }
+}
+
+void cStatic_Geometry::Remove(cSprite* sprite)
+{
+    cStatic_Geometry_Entry& entry = sprite->m_static_geometry_entry;
+    cStatic_Geometry_Chunk* chunk = entry.m_chunk;
+
+    if (!chunk) {
+        return;
+    }
+
+    // move the last one into its place
+    cSprite* last = chunk->m_sprites.back();
+    chunk->m_sprites[entry.m_index] = last;
+    last->m_static_geometry_entry.m_index = entry.m_index;
+
+    chunk->m_sprites.pop_back();
+    chunk->m_dirty = 1;
+
+    entry.m_chunk = NULL;
+    entry.m_index = 0;
+    entry.m_baked = 0;
+}
+
+void cStatic_Geometry::Clear(void)
+{
+    for (Chunk_Map::iterator itr = m_chunks.begin(); itr != m_chunks.end(); ++itr) {
+        cStatic_Geometry_Chunk* chunk = itr->second;
+
+        for (vector<cSprite*>::iterator sprite_itr = chunk->m_sprites.begin(); sprite_itr != chunk->m_sprites.end(); ++sprite_itr) {
+            cStatic_Geometry_Entry& entry = (*sprite_itr)->m_static_geometry_entry;
+            entry.m_chunk = NULL;
+            entry.m_index = 0;
+            entry.m_baked = 0;
+        }
+
+        delete chunk;
+    }
+
+    m_chunks.clear();
+    m_bake_chunks.clear();
+}
+
+bool cStatic_Geometry::Draw(void)
+{
+    const cGL_Extensions& gl_ext = pVideo->m_gl_extensions;
+
+    // sprites draw their debug rects themselves
+    if (game_debug || !gl_ext.Has_Vertex_Buffers()) {
+        return 0;
+    }
+
+    // the buffers were deleted with their context
+    if (m_context_num != gl_ext.m_context_num) {
+        m_context_num = gl_ext.m_context_num;
+
+        for (Chunk_Map::iterator itr = m_chunks.begin(); itr != m_chunks.end(); ++itr) {
+            itr->second->m_vertex_buffer = 0;
+            itr->second->m_dirty = 1;
+        }
+    }
+
+    // the editor draws other images
+    if (m_editor_enabled != editor_enabled) {
+        m_editor_enabled = editor_enabled;
+
+        for (Chunk_Map::iterator itr = m_chunks.begin(); itr != m_chunks.end(); ++itr) {
+            itr->second->m_dirty = 1;
+        }
+    }
+
+    const GL_rect camera_rect(pActive_Camera->m_x, pActive_Camera->m_y, static_cast<float>(game_res_w), static_cast<float>(game_res_h));
+
+    // changed chunks
+    m_bake_chunks.clear();
+
+    for (Chunk_Map::iterator itr = m_chunks.begin(); itr != m_chunks.end(); ++itr) {
+        if (itr->second->m_dirty) {
+            m_bake_chunks.push_back(itr->second);
+        }
+    }
+
+    // baking can add chunks to the list
+    for (size_t i = 0; i < m_bake_chunks.size(); i++) {
+        if (m_bake_chunks[i]->m_dirty) {
+            Bake(m_bake_chunks[i]);
+        }
+    }
+
+    for (Chunk_Map::iterator itr = m_chunks.begin(); itr != m_chunks.end();) {
+        cStatic_Geometry_Chunk* chunk = itr->second;
+
+        // no sprites left
+        if (chunk->m_sprites.empty()) {
+            delete chunk;
+            m_chunks.erase(itr++);
+            continue;
+        }
+
+        if (!chunk->m_runs.empty() && chunk->m_bounds.Intersects(camera_rect)) {
+            for (vector<cStatic_Geometry_Chunk::Run>::const_iterator run_itr = chunk->m_runs.begin(); run_itr != chunk->m_runs.end(); ++run_itr) {
+                const cStatic_Geometry_Chunk::Run& run = *run_itr;
+
+                cVertex_Buffer_Request* request = new cVertex_Buffer_Request();
+                request->m_vertex_buffer = chunk->m_vertex_buffer;
+                request->m_vertex_buffer_context = chunk->m_vertex_buffer_context;
+                request->m_texture_id = run.m_texture_id;
+                request->m_blend_sfactor = run.m_blend_sfactor;
+                request->m_blend_dfactor = run.m_blend_dfactor;
+                request->m_combine_type = run.m_combine_type;
+                request->m_combine_color[0] = run.m_combine_color[0];
+                request->m_combine_color[1] = run.m_combine_color[1];
+                request->m_combine_color[2] = run.m_combine_color[2];
+                request->m_first = run.m_first;
+                request->m_count = run.m_count;
+                request->m_opaque = 1;
+                request->m_pos_z = run.m_pos_z;
+
+                pRenderer->Add(request);
+            }
+        }
+
+        ++itr;
+    }
+
+    return 1;
+}
+
+bool cStatic_Geometry::Get_Request(const cSprite* sprite, cSurface_Request& request)
+{
+    if (!sprite->Is_Image_Drawable()) {
+        return 0;
+    }
+
+    // the sprite draws a warning rect over obsolete images in the editor
+    if (editor_enabled && sprite->m_image && sprite->m_image->m_obsolete) {
+        return 0;
+    }
+
+    if (editor_enabled) {
+        sprite->Draw_Image_Editor(&request);
+    }
+    else {
+        sprite->Draw_Image_Normal(&request);
+    }
+
+    return 1;
+}
+
+cStatic_Geometry_Chunk* cStatic_Geometry::Get_Chunk(float x, float y)
+{
+    const int chunk_x = Get_Chunk_Pos(x);
+    const int chunk_y = Get_Chunk_Pos(y);
+    const uint64_t key = Get_Chunk_Key(chunk_x, chunk_y);
+
+    Chunk_Map::iterator itr = m_chunks.find(key);
+
+    if (itr != m_chunks.end()) {
+        return itr->second;
+    }
+
+    cStatic_Geometry_Chunk* chunk = new cStatic_Geometry_Chunk(chunk_x, chunk_y);
+    m_chunks.insert(std::make_pair(key, chunk));
+
+    return chunk;
+}
+
+void cStatic_Geometry::Insert(cStatic_Geometry_Chunk* chunk, cSprite* sprite)
+{
+    cStatic_Geometry_Entry& entry = sprite->m_static_geometry_entry;
+    entry.m_chunk = chunk;
+    entry.m_index = static_cast<unsigned int>(chunk->m_sprites.size());
+    entry.m_baked = 0;
+
+    chunk->m_sprites.push_back(sprite);
+    chunk->m_dirty = 1;
+}
+
+void cStatic_Geometry::Bake(cStatic_Geometry_Chunk* chunk)
+{
+    m_quads.clear();
+    m_moved_sprites.clear();
+
+    for (size_t i = 0; i < chunk->m_sprites.size(); i++) {
+        cSprite* sprite = chunk->m_sprites[i];
+        sprite->m_static_geometry_entry.m_baked = 0;
+
+        // removed below
+        if (!Is_Static(sprite)) {
+            m_moved_sprites.push_back(sprite);
+            continue;
+        }
+
+        cSurface_Request request;
+
+        if (!Get_Request(sprite, request)) {
+            continue;
+        }
+
+        // now drawn in another chunk
+        if (Get_Chunk_Pos(request.m_pos_x) != chunk->m_x || Get_Chunk_Pos(request.m_pos_y) != chunk->m_y) {
+            m_moved_sprites.push_back(sprite);
+            continue;
+        }
+
+        /* translucent images and shadows must be sorted against the dynamic sprites
+         * and are still drawn by the sprite
+        */
+        if (request.m_shadow_pos || !cRenderQueue::Is_Opaque(&request)) {
+            continue;
+        }
+
+        Baked_Quad quad;
+        quad.m_texture_id = request.m_texture_id;
+        quad.m_blend_sfactor = request.m_blend_sfactor;
+        quad.m_blend_dfactor = request.m_blend_dfactor;
+        quad.m_pos_z = request.m_pos_z;
+        quad.m_order = static_cast<unsigned int>(m_quads.size());
+        quad.m_combine_type = request.m_combine_type;
+        quad.m_combine_color[0] = request.m_combine_color[0];
+        quad.m_combine_color[1] = request.m_combine_color[1];
+        quad.m_combine_color[2] = request.m_combine_color[2];
+        request.Get_Quad(quad.m_vertices, request.m_color, 1);
+
+        m_quads.push_back(quad);
+        sprite->m_static_geometry_entry.m_baked = 1;
+    }
+
+    for (vector<cSprite*>::iterator itr = m_moved_sprites.begin(); itr != m_moved_sprites.end(); ++itr) {
+        Remove(*itr);
+        // does nothing if no longer static
+        Add(*itr);
+
+        cStatic_Geometry_Chunk* new_chunk = (*itr)->m_static_geometry_entry.m_chunk;
+
+        if (new_chunk) {
+            m_bake_chunks.push_back(new_chunk);
+        }
+    }
+
+    chunk->m_dirty = 0;
+    chunk->m_runs.clear();
+    chunk->m_bounds = GL_rect();
+
+    if (m_quads.empty()) {
+        chunk->Delete_Buffer();
+        return;
+    }
+
+    // the same order as the render queue
+    std::sort(m_quads.begin(), m_quads.end(), baked_quad_sort());
+
+    m_vertices.clear();
+
+    float min_x = m_quads[0].m_vertices[0].m_x;
+    float min_y = m_quads[0].m_vertices[0].m_y;
+    float max_x = min_x;
+    float max_y = min_y;
+
+    for (vector<Baked_Quad>::const_iterator itr = m_quads.begin(); itr != m_quads.end(); ++itr) {
+        const Baked_Quad& quad = *itr;
+
+        for (unsigned int i = 0; i < 4; i++) {
+            min_x = std::min(min_x, quad.m_vertices[i].m_x);
+            min_y = std::min(min_y, quad.m_vertices[i].m_y);
+            max_x = std::max(max_x, quad.m_vertices[i].m_x);
+            max_y = std::max(max_y, quad.m_vertices[i].m_y);
+        }
+
+        m_vertices.insert(m_vertices.end(), quad.m_vertices, quad.m_vertices + 4);
+
+        // continue the last run if the state is the same
+        if (!chunk->m_runs.empty()) {
+            cStatic_Geometry_Chunk::Run& last = chunk->m_runs.back();
+
+            if (Get_Z_Range(last.m_pos_z) == Get_Z_Range(quad.m_pos_z) &&
+                    last.m_texture_id == quad.m_texture_id &&
+                    last.m_blend_sfactor == quad.m_blend_sfactor && last.m_blend_dfactor == quad.m_blend_dfactor &&
+                    last.m_combine_type == quad.m_combine_type && (quad.m_combine_type == 0 ||
+                            (last.m_combine_color[0] == quad.m_combine_color[0] && last.m_combine_color[1] == quad.m_combine_color[1] && last.m_combine_color[2] == quad.m_combine_color[2]))) {
+                last.m_count += 4;
+                continue;
+            }
+        }
+
+        cStatic_Geometry_Chunk::Run run;
+        run.m_texture_id = quad.m_texture_id;
+        run.m_blend_sfactor = quad.m_blend_sfactor;
+        run.m_blend_dfactor = quad.m_blend_dfactor;
+        run.m_combine_type = quad.m_combine_type;
+        run.m_combine_color[0] = quad.m_combine_color[0];
+        run.m_combine_color[1] = quad.m_combine_color[1];
+        run.m_combine_color[2] = quad.m_combine_color[2];
+        run.m_pos_z = quad.m_pos_z;
+        run.m_first = static_cast<GLint>(m_vertices.size() - 4);
+        run.m_count = 4;
+
+        chunk->m_runs.push_back(run);
+    }
+
+    chunk->m_bounds = GL_rect(min_x, min_y, max_x - min_x, max_y - min_y);
+
+    if (!chunk->m_vertex_buffer) {
+        chunk->m_vertex_buffer = pVideo->Gen_Buffer();
+        chunk->m_vertex_buffer_context = pVideo->m_gl_extensions.m_context_num;
+    }
+
+    // queued if the render thread is drawing the previous frame with the old data
+    pVideo->Set_Buffer_Data(chunk->m_vertex_buffer, &m_vertices[0], m_vertices.size() * sizeof(Render_Vertex), GL_STATIC_DRAW);
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,190 @@
+/***************************************************************************
+ * static_geometry.hpp - Cached vertex buffers of non-moving level sprites
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_STATIC_GEOMETRY_HPP
+#define TSC_STATIC_GEOMETRY_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/math/rect.hpp"
+#include "../video/renderer.hpp"
+
+namespace TSC {
+
+    class cSprite;
+    class cStatic_Geometry_Chunk;
+
+    /* *** *** *** *** *** *** *** cStatic_Geometry_Entry *** *** *** *** *** *** *** *** *** *** */
+
+    /* The chunk a static sprite is cached in.
+     * Copying a sprite never copies the registration.
+     */
+    class cStatic_Geometry_Entry {
+    public:
+        cStatic_Geometry_Entry(void)
+            : m_chunk(NULL), m_index(0), m_baked(0) {}
+        cStatic_Geometry_Entry(const cStatic_Geometry_Entry&)
+            : m_chunk(NULL), m_index(0), m_baked(0) {}
+
+        inline cStatic_Geometry_Entry& operator = (const cStatic_Geometry_Entry&)
+        {
+            return *this;
+        }
+
+        // the chunk this sprite is stored in or NULL
+        cStatic_Geometry_Chunk* m_chunk;
+        // index in the chunk sprite list
+        unsigned int m_index;
+        // if the chunk draws the sprite image instead of the sprite
+        bool m_baked;
+    };
+
+    /* *** *** *** *** *** *** *** cStatic_Geometry_Chunk *** *** *** *** *** *** *** *** *** *** */
+
+    class cStatic_Geometry_Chunk {
+    public:
+        cStatic_Geometry_Chunk(int x, int y);
+        ~cStatic_Geometry_Chunk(void);
+
+        // Delete the vertex buffer if its context still exists
+        void Delete_Buffer(void);
+
+        // quads next to each other in z order drawn with the same state
+        struct Run {
+            GLuint m_texture_id;
+            GLenum m_blend_sfactor;
+            GLenum m_blend_dfactor;
+            GLint m_combine_type;
+            float m_combine_color[3];
+            // z position of the first quad
+            float m_pos_z;
+            // vertices in the buffer
+            GLint m_first;
+            GLsizei m_count;
+        };
+
+        // position in chunks
+        int m_x;
+        int m_y;
+        // cached sprites
+        vector<cSprite*> m_sprites;
+        // baked quads sorted by z position
+        vector<Run> m_runs;
+        // vertex buffer object or 0 if not created
+        GLuint m_vertex_buffer;
+        // context the vertex buffer belongs to
+        unsigned int m_vertex_buffer_context;
+        // level rect of all baked vertices
+        GL_rect m_bounds;
+        // the drawn image of a sprite changed and it needs to be baked again
+        bool m_dirty;
+    };
+
+    /* *** *** *** *** *** *** *** cStatic_Geometry *** *** *** *** *** *** *** *** *** *** */
+
+    /* Caches the images of plain level sprites which normally never move
+     * in one vertex buffer per square chunk of the level.
+     * A chunk is baked again if one of its sprites is added or removed, or
+     * if a sprite setter changing the drawn image marks it dirty.
+     * Only fully opaque images without a shadow are baked as they do not
+     * depend on the drawing order. Every run of quads with the same state is
+     * added to the render queue with the z position of its first quad and
+     * the depth test places the quads in front of or behind the dynamic
+     * sprites. Translucent sprites draw themselves and are sorted as usual.
+     * Runs never span more than one massive type z range.
+     * Without vertex buffer objects or while debugging the sprites draw
+     * themselves.
+     */
+    class cStatic_Geometry {
+    public:
+        cStatic_Geometry(void);
+        ~cStatic_Geometry(void);
+
+        // Return true if the sprite can be cached
+        static bool Is_Static(const cSprite* sprite);
+
+        // Store the sprite if it can be cached
+        void Add(cSprite* sprite);
+        // Remove the sprite from its chunk if stored
+        static void Remove(cSprite* sprite);
+        // Remove all sprites and delete the chunks
+        void Clear(void);
+
+        /* Bake the changed chunks and add the render requests of the visible ones
+         * returns false if not available and every sprite must draw itself
+        */
+        bool Draw(void);
+
+        // chunk width and height in level pixels
+        static const float m_chunk_size;
+
+    private:
+        typedef std::map<uint64_t, cStatic_Geometry_Chunk*> Chunk_Map;
+
+        // a quad to bake with its state
+        struct Baked_Quad {
+            // sort position
+            float m_pos_z;
+            unsigned int m_order;
+
+            GLuint m_texture_id;
+            GLenum m_blend_sfactor;
+            GLenum m_blend_dfactor;
+            GLint m_combine_type;
+            float m_combine_color[3];
+            Render_Vertex m_vertices[4];
+        };
+
+        struct baked_quad_sort {
+            bool operator()(const Baked_Quad& a, const Baked_Quad& b) const
+            {
+                if (a.m_pos_z != b.m_pos_z) {
+                    return a.m_pos_z < b.m_pos_z;
+                }
+
+                return a.m_order < b.m_order;
+            }
+        };
+
+        /* Fill the request like the sprite does when drawing its image
+         * returns false if the sprite image is not drawn
+        */
+        static bool Get_Request(const cSprite* sprite, cSurface_Request& request);
+        // Return the chunk at the given level position and create it if needed
+        cStatic_Geometry_Chunk* Get_Chunk(float x, float y);
+        // Store the sprite in the chunk
+        void Insert(cStatic_Geometry_Chunk* chunk, cSprite* sprite);
+        /* Build the vertex buffer of the chunk
+         * sprites now in another chunk are moved to it which is then baked as well
+        */
+        void Bake(cStatic_Geometry_Chunk* chunk);
+
+        Chunk_Map m_chunks;
+        // chunks to bake in this frame
+        vector<cStatic_Geometry_Chunk*> m_bake_chunks;
+        // temporary data while baking
+        vector<Baked_Quad> m_quads;
+        vector<Render_Vertex> m_vertices;
+        vector<cSprite*> m_moved_sprites;
+        // context the vertex buffers were created in
+        unsigned int m_context_num;
+        // if baked with the editor images
+        bool m_editor_enabled;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -0,0 +1,191 @@
+/***************************************************************************
+ * texture_atlas.cpp - Shared textures holding several small images
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/texture_atlas.hpp"
+#include "../video/gl_surface.hpp"
+#include "../video/video.hpp"
+#include "../video/img_manager.hpp"
+
+using namespace std;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** cTexture_Atlas *** *** *** *** *** *** *** *** *** *** *** */
+
+const unsigned int cTexture_Atlas::m_max_image_size = 256;
+const unsigned int cTexture_Atlas::m_page_size = 2048;
+const unsigned int cTexture_Atlas::m_border = 1;
+
+cTexture_Atlas::cTexture_Atlas(void)
+{
+
+}
+
+cTexture_Atlas::~cTexture_Atlas(void)
+{
+    Clear();
+}
+
+bool cTexture_Atlas::Add(cGL_Surface* surface, unsigned int width, unsigned int height, const void* pixels)
+{
+    if (!surface || !pixels || !width || !height || width > m_max_image_size || height > m_max_image_size) {
+        return 0;
+    }
+
+    const unsigned int full_w = width + (m_border * 2);
+    const unsigned int full_h = height + (m_border * 2);
+    unsigned int x = 0;
+    unsigned int y = 0;
+    Page* page = NULL;
+
+    // the last pages have the most free space
+    for (vector<Page>::reverse_iterator itr = m_pages.rbegin(); itr != m_pages.rend(); ++itr) {
+        if (Insert(*itr, full_w, full_h, x, y)) {
+            page = &(*itr);
+            break;
+        }
+    }
+
+    if (!page) {
+        if (!Add_Page() || !Insert(m_pages.back(), full_w, full_h, x, y)) {
+            return 0;
+        }
+
+        page = &m_pages.back();
+    }
+
+    // copy with the edge pixels repeated into the border
+    const GLubyte* src = static_cast<const GLubyte*>(pixels);
+    vector<GLubyte> data(full_w * full_h * 4);
+
+    for (unsigned int dest_y = 0; dest_y < full_h; dest_y++) {
+        const unsigned int src_y = std::min(height - 1, dest_y > m_border ? dest_y - m_border : 0);
+
+        for (unsigned int dest_x = 0; dest_x < full_w; dest_x++) {
+            const unsigned int src_x = std::min(width - 1, dest_x > m_border ? dest_x - m_border : 0);
+
+            memcpy(&data[(dest_y * full_w + dest_x) * 4], &src[(src_y * width + src_x) * 4], 4);
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, page->m_texture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, full_w, full_h, GL_RGBA, GL_UNSIGNED_BYTE, &data[0]);
+
+    const float page_size = static_cast<float>(page->m_size);
+
+    surface->m_image = page->m_texture;
+    surface->m_tex_left = static_cast<float>(x + m_border) / page_size;
+    surface->m_tex_top = static_cast<float>(y + m_border) / page_size;
+    surface->m_tex_right = static_cast<float>(x + m_border + width) / page_size;
+    surface->m_tex_bottom = static_cast<float>(y + m_border + height) / page_size;
+    surface->m_atlas = 1;
+
+    return 1;
+}
+
+void cTexture_Atlas::Clear(void)
+{
+    for (vector<Page>::iterator itr = m_pages.begin(); itr != m_pages.end(); ++itr) {
+        if (glIsTexture(itr->m_texture)) {
+            glDeleteTextures(1, &itr->m_texture);
+        }
+    }
+
+    m_pages.clear();
+}
+
+bool cTexture_Atlas::Insert(Page& page, unsigned int width, unsigned int height, unsigned int& x, unsigned int& y) const
+{
+    Shelf* best = NULL;
+
+    // lowest shelf the image fits in
+    for (vector<Shelf>::iterator itr = page.m_shelves.begin(); itr != page.m_shelves.end(); ++itr) {
+        if (itr->m_height < height || page.m_size - itr->m_used_w < width) {
+            continue;
+        }
+
+        if (!best || itr->m_height < best->m_height) {
+            best = &(*itr);
+        }
+    }
+
+    // start a new shelf if the best one would waste more than half of its height
+    if ((!best || best->m_height > height * 2) && page.m_size - page.m_used_h >= height && page.m_size >= width) {
+        Shelf shelf;
+        shelf.m_y = page.m_used_h;
+        shelf.m_height = height;
+        shelf.m_used_w = 0;
+
+        page.m_shelves.push_back(shelf);
+        page.m_used_h += height;
+        best = &page.m_shelves.back();
+    }
+
+    if (!best) {
+        return 0;
+    }
+
+    x = best->m_used_w;
+    y = best->m_y;
+    best->m_used_w += width;
+
+    return 1;
+}
+
+bool cTexture_Atlas::Add_Page(void)
+{
+    Page page;
+    page.m_texture = 0;
+    page.m_size = std::min(m_page_size, static_cast<unsigned int>(pVideo->m_max_texture_size));
+    page.m_used_h = 0;
+
+    // must hold at least one image
+    if (page.m_size < m_max_image_size + (m_border * 2)) {
+        return 0;
+    }
+
+    glGenTextures(1, &page.m_texture);
+
+    if (!page.m_texture) {
+        cerr << "Error : GL atlas texture generation failed" << endl;
+        return 0;
+    }
+
+    // set highest texture id
+    if (pImage_Manager->m_high_texture_id < page.m_texture) {
+        pImage_Manager->m_high_texture_id = page.m_texture;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, page.m_texture);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+    // transparent
+    vector<GLubyte> data(page.m_size * page.m_size * 4, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, page.m_size, page.m_size, 0, GL_RGBA, GL_UNSIGNED_BYTE, &data[0]);
+
+    m_pages.push_back(page);
+
+    debug_print("Texture atlas : page %u with %ux%u created\n", static_cast<unsigned int>(m_pages.size()), page.m_size, page.m_size);
+
+    return 1;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,94 @@
+/***************************************************************************
+ * texture_atlas.hpp - Shared textures holding several small images
+ *
+ * Copyright © 2012-2017 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_TEXTURE_ATLAS_HPP
+#define TSC_TEXTURE_ATLAS_HPP
+
+#include "../core/global_basic.hpp"
+
+namespace TSC {
+
+    class cGL_Surface;
+
+    /* *** *** *** *** *** *** *** cTexture_Atlas *** *** *** *** *** *** *** *** *** *** */
+
+    /* Packs small images into a few large textures ( pages ) so that
+     * sprites using different images can be drawn without binding
+     * another texture in between.
+     * Every image gets a border of its repeated edge pixels which makes
+     * linear filtering look the same as GL_CLAMP_TO_EDGE on a texture
+     * of its own. Images with mipmaps or other wrap modes can't be packed.
+     * Space is only given back by Clear() as the images are cached
+     * by the image manager anyway.
+     */
+    class cTexture_Atlas {
+    public:
+        cTexture_Atlas(void);
+        ~cTexture_Atlas(void);
+
+        /* Copy the RGBA pixels into a page and set the surface texture
+         * and texture coordinates to it
+         * returns false if the image is too big and needs its own texture
+        */
+        bool Add(cGL_Surface* surface, unsigned int width, unsigned int height, const void* pixels);
+
+        // Delete all pages, surfaces using them must be reloaded
+        void Clear(void);
+
+        // Return the number of pages
+        inline size_t Get_Page_Count(void) const
+        {
+            return m_pages.size();
+        }
+
+        // images with a bigger width or height get their own texture
+        static const unsigned int m_max_image_size;
+        // page width and height if supported
+        static const unsigned int m_page_size;
+        // edge pixels added on every side of an image
+        static const unsigned int m_border;
+
+    private:
+        // row of images with the height of the first one
+        struct Shelf {
+            unsigned int m_y;
+            unsigned int m_height;
+            // width used from the left
+            unsigned int m_used_w;
+        };
+
+        struct Page {
+            GLuint m_texture;
+            unsigned int m_size;
+            vector<Shelf> m_shelves;
+            // height used from the top
+            unsigned int m_used_h;
+        };
+
+        /* Find space for the given size in the page
+         * returns false if it does not fit
+        */
+        bool Insert(Page& page, unsigned int width, unsigned int height, unsigned int& x, unsigned int& y) const;
+        // Create a new empty page
+        bool Add_Page(void);
+
+        vector<Page> m_pages;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
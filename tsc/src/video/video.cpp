@@ -64,7 +64,7 @@ cVideo::cVideo(void)
 #ifdef __unix__
     glx_context = NULL;
 #endif
-    m_render_thread = boost::thread();
+    m_render_pending = 0;
 
     mp_cegui_renderer = NULL;
     mp_default_tooltip = NULL;
@@ -74,6 +74,9 @@ cVideo::cVideo(void)
 
 cVideo::~cVideo(void)
 {
+    Render_Finish();
+    m_render_thread.Stop();
+
     if (mp_default_tooltip) {
         CEGUI::WindowManager::getSingleton().destroyWindow(mp_default_tooltip);
         CEGUI::System::getSingleton().getDefaultGUIContext().setDefaultTooltipObject(0);
@@ -81,7 +84,16 @@ cVideo::~cVideo(void)
     }
 
     CEGUI::System::destroy();
-    CEGUI::OpenGLRenderer::destroy(*mp_cegui_renderer);
+#ifdef ENABLE_HEADLESS
+    if (game_headless) {
+        CEGUI::NullRenderer::destroy(*static_cast<CEGUI::NullRenderer*>(mp_cegui_renderer));
+    }
+    else {
+        CEGUI::OpenGLRenderer::destroy(*static_cast<CEGUI::OpenGLRenderer*>(mp_cegui_renderer));
+    }
+#else
+    CEGUI::OpenGLRenderer::destroy(*static_cast<CEGUI::OpenGLRenderer*>(mp_cegui_renderer));
+#endif
     mp_cegui_renderer = NULL;
 
     if (mp_window) {
@@ -96,10 +108,20 @@ void cVideo::Init_CEGUI(void)
     debug_print("CEGUI log file is at '%s'.\n", utf8_logpath.c_str());
 
     // create CEGUI renderer and system objects
+#ifdef ENABLE_HEADLESS
+    // lays out and renders the GUI without drawing anything
+    if (game_headless) {
+        mp_cegui_renderer = &CEGUI::NullRenderer::create();
+    }
+    else {
+        mp_cegui_renderer = &CEGUI::OpenGLRenderer::create();
+    }
+#else
     mp_cegui_renderer = &CEGUI::OpenGLRenderer::create();
+#endif
     CEGUI::System::create(*mp_cegui_renderer, NULL, NULL, NULL, NULL, "", utf8_logpath);
 
-    // Retrieve default resource provider for the OpenGLRenderer
+    // Retrieve default resource provider for the renderer
     CEGUI::DefaultResourceProvider* p_rp
         = static_cast<CEGUI::DefaultResourceProvider*>(CEGUI::System::getSingleton().getResourceProvider());
 
@@ -135,8 +157,10 @@ void cVideo::Init_CEGUI(void)
     gui_context.getMouseCursor().setDefaultImage("TaharezLook/MouseArrow");
 
     // set initial mouse position
-    sf::Vector2i mousepos = sf::Mouse::getPosition(*pVideo->mp_window);
-    CEGUI::MouseCursor::setInitialMousePosition(CEGUI::Vector2f(mousepos.x, mousepos.y));
+    if (!game_headless) {
+        sf::Vector2i mousepos = sf::Mouse::getPosition(*pVideo->mp_window);
+        CEGUI::MouseCursor::setInitialMousePosition(CEGUI::Vector2f(mousepos.x, mousepos.y));
+    }
 
     // Create the invisible root window
     CEGUI::Window* p_rootwindow = CEGUI::WindowManager::getSingleton().createWindow("DefaultWindow", "root");
@@ -154,6 +178,11 @@ void cVideo::Init_Video(bool reload_textures_from_file /* = false */, bool use_p
 {
     Render_Finish();
 
+    if (game_headless) {
+        Init_Video_Headless();
+        return;
+    }
+
     sf::VideoMode videomode(800, 600, 16); // defaults
     sf::VideoMode desktopmode(sf::VideoMode::getDesktopMode());
     if (use_preferences) {
@@ -207,7 +236,7 @@ void cVideo::Init_Video(bool reload_textures_from_file /* = false */, bool use_p
 
         // save textures
         pImage_Manager->Grab_Textures(reload_textures_from_file, 1);
-        mp_cegui_renderer->grabTextures();
+        static_cast<CEGUI::OpenGLRenderer*>(mp_cegui_renderer)->grabTextures();
         pImage_Manager->Delete_Hardware_Textures();
 
         // exit loading screen
@@ -230,6 +259,9 @@ void cVideo::Init_Video(bool reload_textures_from_file /* = false */, bool use_p
 
     // initialize opengl
     Init_OpenGL();
+    // load functions for the new context
+    m_gl_extensions.Init();
+    m_sprite_shader.Init(pPreferences->m_video_shaders);
 
     // if reinitialization
     if (m_initialised) {
@@ -239,7 +271,7 @@ void cVideo::Init_Video(bool reload_textures_from_file /* = false */, bool use_p
         /* restore GUI textures
          * must be the first CEGUI call after the grabTextures function
         */
-        mp_cegui_renderer->restoreTextures();
+        static_cast<CEGUI::OpenGLRenderer*>(mp_cegui_renderer)->restoreTextures();
 
         // send new size to CEGUI
         CEGUI::System::getSingleton().notifyDisplaySizeChanged(CEGUI::Sizef(static_cast<float>(videomode.width), static_cast<float>(videomode.height)));
@@ -299,6 +331,33 @@ void cVideo::Init_Video(bool reload_textures_from_file /* = false */, bool use_p
     }
 }
 
+void cVideo::Init_Video_Headless(void)
+{
+    // the desktop size is unknown without a display
+    if (pPreferences->m_video_screen_w == 0 || pPreferences->m_video_screen_h == 0) {
+        pPreferences->m_video_screen_w = cPreferences::m_video_screen_w_default;
+        pPreferences->m_video_screen_h = cPreferences::m_video_screen_h_default;
+    }
+
+    // a common limit so that images are scaled like on real hardware
+    m_max_texture_size = 4096;
+    m_double_buffer = true;
+
+    if (m_initialised) {
+        // send new size to CEGUI
+        CEGUI::System::getSingleton().notifyDisplaySizeChanged(CEGUI::Sizef(static_cast<float>(pPreferences->m_video_screen_w), static_cast<float>(pPreferences->m_video_screen_h)));
+        // Tell the HUD about the size change so it can adapt
+        gp_hud->Screen_Size_Changed();
+        return;
+    }
+
+    debug_print("Headless mode : no window and no OpenGL context\n");
+
+    Init_CEGUI();
+
+    m_initialised = 1;
+}
+
 void cVideo::Init_OpenGL(void)
 {
     // viewport should cover the whole screen
@@ -320,8 +379,13 @@ void cVideo::Init_OpenGL(void)
     glShadeModel(GL_SMOOTH);
 
     // set clear color to black
+    m_clear_color = black;
     glClearColor(0, 0, 0, 1);
 
+    // prepared names of a previous context are not valid anymore
+    m_texture_names.clear();
+    m_buffer_names.clear();
+
     // Z-Buffer
     glEnable(GL_DEPTH_TEST);
 
@@ -651,54 +715,31 @@ vector<cSize_Int> cVideo::Get_Supported_Resolutions(int flags /* = 0 */) const
 
 void cVideo::Make_GL_Context_Current(void)
 {
-// Not ported to SFML yet, because unused function
-// Part of the unfinished separate rendering thread implementation in TSC
-// (TSC_RENDER_THREAD_TEST macro).
-    throw(std::runtime_error("Make_GL_Context_Current() not implemented"));
-
-// scoped context lock here
-//#ifdef _WIN32
-//    if (wglGetCurrentContext() != wm_info.hglrc) {
-//        wglMakeCurrent(GetDC(wm_info.window), wm_info.hglrc);
-//    }
-//#elif __unix__
-//    if (glx_context != NULL) {
-//        glXMakeCurrent(wm_info.info.x11.gfxdisplay, wm_info.info.x11.window, glx_context);
-//    }
-//#elif __APPLE__
-//    // party time
-//#endif
+    mp_window->setActive(1);
 }
 
 void cVideo::Make_GL_Context_Inactive(void)
 {
-#ifdef _WIN32
-    wglMakeCurrent(NULL, NULL);
-#elif __unix__
-    // OLD glXMakeCurrent(wm_info.info.x11.gfxdisplay, None, NULL);
-#elif __APPLE__
-    // party time
-#endif
-}
-
-void cVideo::Render_From_Thread(void)
-{
-    Make_GL_Context_Current();
-
-    pRenderer_current->Render();
-    // under linux with sofware mesa 7.9 it only showed the rendered output with SDL_GL_SwapBuffers()
-
-    // update performance timer
-    //pFramerate->m_perf_timer[PERF_RENDER_GAME]->Update();
-
-    Make_GL_Context_Inactive();
+    mp_window->setActive(0);
 }
 
 void cVideo::Render(bool threaded /* = 0 */)
 {
+    // the previous frame
     Render_Finish();
 
+    // there is no context to hand over
+    if (game_headless) {
+        threaded = 0;
+    }
+
     if (threaded) {
+        // update performance timer
+        pFramerate->m_perf_timer[PERF_RENDER_GAME]->Update();
+        pFramerate->m_perf_timer[PERF_RENDER_GAME_DRAW_CALLS]->Set_Count(pRenderer_current->m_draw_calls);
+        pFramerate->m_perf_timer[PERF_RENDER_GAME_OPAQUE_DRAW_CALLS]->Set_Count(pRenderer_current->m_opaque_draw_calls);
+
+        // CEGUI is not thread safe and renders on top of the finished frame
         CEGUI::System::getSingleton().renderAllGUIContexts();
 
         // update performance timer
@@ -709,6 +750,9 @@ void cVideo::Render(bool threaded /* = 0 */)
         // update performance timer
         pFramerate->m_perf_timer[PERF_RENDER_BUFFER]->Update();
 
+        // the game moves the camera while the thread renders
+        pRenderer->Store_Camera();
+
         // switch active renderer
         cRenderQueue* new_render = pRenderer;
         pRenderer = pRenderer_current;
@@ -720,17 +764,28 @@ void cVideo::Render(bool threaded /* = 0 */)
             pRenderer->m_render_data.clear();
         }
 
-        // make main thread inactive
+        // names for textures and buffers created while the thread renders
+        Fill_GL_Names();
+
+        // the render thread takes over the context
         Make_GL_Context_Inactive();
-        // start render thread
-        m_render_thread = boost::thread(&cVideo::Render_From_Thread, this);
+        m_render_thread.Start();
+        m_render_thread.Submit(pRenderer_current, mp_window);
+        m_render_pending = 1;
     }
     // single thread mode
     else {
+        // switched off
+        if (m_render_thread.Is_Running()) {
+            m_render_thread.Stop();
+        }
+
         pRenderer->Render();
 
         // update performance timer
         pFramerate->m_perf_timer[PERF_RENDER_GAME]->Update();
+        pFramerate->m_perf_timer[PERF_RENDER_GAME_DRAW_CALLS]->Set_Count(pRenderer->m_draw_calls);
+        pFramerate->m_perf_timer[PERF_RENDER_GAME_OPAQUE_DRAW_CALLS]->Set_Count(pRenderer->m_opaque_draw_calls);
 
         // Render GUI after everything else, i.e. on top of everything
         CEGUI::System::getSingleton().renderAllGUIContexts();
@@ -747,17 +802,124 @@ void cVideo::Render(bool threaded /* = 0 */)
 
 void cVideo::Render_Finish(void)
 {
-#ifndef TSC_RENDER_THREAD_TEST
-    return;
-#endif
-    if (m_render_thread.joinable()) {
-        m_render_thread.join();
+    if (!m_render_pending) {
+        return;
     }
 
-    // todo : use opengl in only one thread
+    m_render_thread.Wait();
+    m_render_pending = 0;
+
+    // the render thread released the context
     Make_GL_Context_Current();
 }
 
+GLuint cVideo::Gen_Texture(void)
+{
+    GLuint texture_id = 0;
+
+    if (m_render_pending && m_texture_names.empty()) {
+        debug_print("Warning : no prepared texture name left, waiting for the render thread\n");
+        Render_Finish();
+    }
+
+    if (m_render_pending) {
+        texture_id = m_texture_names.back();
+        m_texture_names.pop_back();
+    }
+    // unique names so that the render queue batches like with real textures
+    else if (game_headless) {
+        texture_id = pImage_Manager->m_high_texture_id + 1;
+    }
+    else {
+        glGenTextures(1, &texture_id);
+    }
+
+    // set highest texture id
+    if (pImage_Manager->m_high_texture_id < texture_id) {
+        pImage_Manager->m_high_texture_id = texture_id;
+    }
+
+    return texture_id;
+}
+
+void cVideo::Delete_Texture(GLuint texture_id)
+{
+    if (!texture_id || game_headless) {
+        return;
+    }
+
+    if (m_render_pending) {
+        pRenderer->m_delete_textures.push_back(texture_id);
+    }
+    else if (glIsTexture(texture_id)) {
+        glDeleteTextures(1, &texture_id);
+    }
+}
+
+GLuint cVideo::Gen_Buffer(void)
+{
+    GLuint buffer = 0;
+
+    if (m_render_pending && m_buffer_names.empty()) {
+        debug_print("Warning : no prepared buffer name left, waiting for the render thread\n");
+        Render_Finish();
+    }
+
+    if (m_render_pending) {
+        buffer = m_buffer_names.back();
+        m_buffer_names.pop_back();
+    }
+    else {
+        m_gl_extensions.glGenBuffers(1, &buffer);
+    }
+
+    return buffer;
+}
+
+void cVideo::Delete_Buffer(GLuint buffer)
+{
+    if (!buffer) {
+        return;
+    }
+
+    if (m_render_pending) {
+        pRenderer->m_delete_buffers.push_back(buffer);
+    }
+    else {
+        m_gl_extensions.glDeleteBuffers(1, &buffer);
+    }
+}
+
+void cVideo::Set_Buffer_Data(GLuint buffer, const void* data, size_t size, GLenum usage)
+{
+    if (m_render_pending) {
+        pRenderer->Add_Command(new cBuffer_Data_Command(buffer, data, size, usage));
+        return;
+    }
+
+    m_gl_extensions.glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    m_gl_extensions.glBufferData(GL_ARRAY_BUFFER, size, data, usage);
+    m_gl_extensions.glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void cVideo::Fill_GL_Names(void)
+{
+    // enough for a frame which loads a few images
+    const size_t pool_size = 16;
+
+    if (m_texture_names.size() < pool_size) {
+        const size_t count = pool_size - m_texture_names.size();
+        m_texture_names.resize(pool_size);
+        glGenTextures(static_cast<GLsizei>(count), &m_texture_names[pool_size - count]);
+    }
+
+    if (m_gl_extensions.Has_Vertex_Buffers() && m_buffer_names.size() < pool_size) {
+        const size_t count = pool_size - m_buffer_names.size();
+        m_buffer_names.resize(pool_size);
+        m_gl_extensions.glGenBuffers(static_cast<GLsizei>(count), &m_buffer_names[pool_size - count]);
+    }
+}
+
 void cVideo::Toggle_Fullscreen(void)
 {
     Render_Finish();
@@ -766,14 +928,13 @@ void cVideo::Toggle_Fullscreen(void)
     pPreferences->m_video_fullscreen = !pPreferences->m_video_fullscreen;
 
     // save clear color
-    GLclampf clear_color[4];
-    glGetFloatv(GL_COLOR_CLEAR_VALUE, clear_color);
+    const Color clear_color = m_clear_color;
 
     // Video must be reinitialized
     Init_Video();
 
     // set back clear color
-    glClearColor(clear_color[0], clear_color[1], clear_color[2], clear_color[3]);
+    m_clear_color = clear_color;
 }
 
 cGL_Surface* cVideo::Get_Surface(fs::path filename, bool print_errors /* = true */)
@@ -813,8 +974,8 @@ cGL_Surface* cVideo :: Get_Surface_Helper(fs::path filename, bool print_errors /
         return image;
     }
 
-    // load new image
-    image = Load_GL_Surface_Helper(path_to_utf8(filename), 1, print_errors, package);
+    // load new image, managed images are kept and can share an atlas page
+    image = Load_GL_Surface_Helper(path_to_utf8(filename), 1, print_errors, package, 1);
     // add new image
     if (image) {
         pImage_Manager->Add(image);
@@ -947,7 +1108,7 @@ cGL_Surface* cVideo :: Load_GL_Package_Surface(boost::filesystem::path filename,
     return Load_GL_Surface_Helper(filename, use_settings, print_errors, 1);
 }
 
-cGL_Surface* cVideo :: Load_GL_Surface_Helper(boost::filesystem::path filename, bool use_settings /* = 1 */, bool print_errors /* = 1 */, bool package /* = 1 */)
+cGL_Surface* cVideo :: Load_GL_Surface_Helper(boost::filesystem::path filename, bool use_settings /* = 1 */, bool print_errors /* = 1 */, bool package /* = 1 */, bool atlas /* = 0 */)
 {
     using namespace boost::filesystem;
 
@@ -977,14 +1138,14 @@ cGL_Surface* cVideo :: Load_GL_Surface_Helper(boost::filesystem::path filename,
         cSize_Int size = settings->Get_Surface_Size(p_sf_image);
         Apply_Max_Texture_Size(size.m_width, size.m_height);
         // get basic settings surface
-        image = pVideo->Create_Texture(p_sf_image, settings->m_mipmap, size.m_width, size.m_height);
+        image = pVideo->Create_Texture(p_sf_image, settings->m_mipmap, size.m_width, size.m_height, atlas);
         // apply settings
         settings->Apply(image);
         delete settings;
     }
     // without settings
     else {
-        image = Create_Texture(p_sf_image);
+        image = Create_Texture(p_sf_image, 0, 0, 0, atlas);
     }
     // set filenames
     if (image) {
@@ -1029,35 +1190,33 @@ sf::Image* cVideo::Convert_To_Final_Software_Image(sf::Image* p_sf_image) const
     return p_sf_image;
 }
 
-cGL_Surface* cVideo::Create_Texture(sf::Image* p_sf_image, bool mipmap /* = 0 */, unsigned int force_width /* = 0 */, unsigned int force_height /* = 0 */) const
+// Return true if every pixel has the full alpha value
+static bool Is_Image_Opaque(const sf::Image* p_sf_image)
 {
-    if (!p_sf_image) {
-        return NULL;
-    }
+    const sf::Uint8* pixels = p_sf_image->getPixelsPtr();
+    const size_t size = static_cast<size_t>(p_sf_image->getSize().x) * p_sf_image->getSize().y * 4;
 
-    // create final image
-    p_sf_image = Convert_To_Final_Software_Image(p_sf_image);
+    if (!pixels) {
+        return 0;
+    }
 
-    /* todo : Make this a render request because it forces an early thread render finish as opengl commands are used directly.
-     * Reduces performance if the render thread is on. It's usually called from the text rendering in cTimeDisplay::Update.
-    */
-    pVideo->Render_Finish();
+    for (size_t i = 3; i < size; i += 4) {
+        if (pixels[i] != 255) {
+            return 0;
+        }
+    }
 
-    // create one texture
-    GLuint image_num = 0;
-    glGenTextures(1, &image_num);
+    return 1;
+}
 
-    // if image id is 0 it failed
-    if (!image_num) {
-        cerr << "Error : GL image generation failed" << endl;
-        delete p_sf_image;
+cGL_Surface* cVideo::Create_Texture(sf::Image* p_sf_image, bool mipmap /* = 0 */, unsigned int force_width /* = 0 */, unsigned int force_height /* = 0 */, bool atlas /* = 0 */) const
+{
+    if (!p_sf_image) {
         return NULL;
     }
 
-    // set highest texture id
-    if (pImage_Manager->m_high_texture_id < image_num) {
-        pImage_Manager->m_high_texture_id = image_num;
-    }
+    // create final image
+    p_sf_image = Convert_To_Final_Software_Image(p_sf_image);
 
     int width = p_sf_image->getSize().x;
     int height = p_sf_image->getSize().y;
@@ -1099,25 +1258,42 @@ cGL_Surface* cVideo::Create_Texture(sf::Image* p_sf_image, bool mipmap /* = 0 */
         free(new_pixels);
     }
 
-    // use the generated texture
-    glBindTexture(GL_TEXTURE_2D, image_num);
+    // create OpenGL surface class
+    cGL_Surface* image = new cGL_Surface();
+    // the power of 2 padding is transparent and makes the image translucent
+    image->m_opaque = Is_Image_Opaque(p_sf_image);
 
-    // set texture wrap modes which control how to interpret texture coordinates
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    // set texture magnification function
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    // upload to OpenGL texture
-    Create_GL_Texture(texture_width, texture_height, p_sf_image->getPixelsPtr(), mipmap);
+    /* mipmaps need a texture of their own
+     * the atlas updates its pages directly which needs the context
+    */
+    if (atlas && !mipmap && !Is_Render_Pending() && !game_headless && pImage_Manager->m_atlas.Add(image, texture_width, texture_height, p_sf_image->getPixelsPtr())) {
+        delete p_sf_image;
+    }
+    else {
+        // create one texture
+        GLuint image_num = pVideo->Gen_Texture();
+
+        // if image id is 0 it failed
+        if (!image_num) {
+            cerr << "Error : GL image generation failed" << endl;
+            delete p_sf_image;
+            delete image;
+            return NULL;
+        }
 
-    // unset pixel store mode
-    // OLD (see corresponding call further above) glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        // while the render thread uses the context the upload is queued
+        if (Is_Render_Pending()) {
+            // takes the image
+            pRenderer->Add_Command(new cTexture_Upload_Command(image_num, texture_width, texture_height, p_sf_image, mipmap));
+        }
+        else {
+            Upload_Texture(image_num, texture_width, texture_height, p_sf_image->getPixelsPtr(), mipmap);
+            delete p_sf_image;
+        }
 
-    delete p_sf_image;
+        image->m_image = image_num;
+    }
 
-    // create OpenGL surface class
-    cGL_Surface* image = new cGL_Surface();
-    image->m_image = image_num;
     image->m_tex_w = texture_width;
     image->m_tex_h = texture_height;
     image->m_start_w = static_cast<float>(width);
@@ -1129,17 +1305,38 @@ cGL_Surface* cVideo::Create_Texture(sf::Image* p_sf_image, bool mipmap /* = 0 */
 
     // if debug build check for errors
 #ifdef _DEBUG
-    // glGetError only saves one error flag
-    GLenum error = glGetError();
+    if (!Is_Render_Pending() && !game_headless) {
+        // glGetError only saves one error flag
+        GLenum error = glGetError();
 
-    if (error != GL_NO_ERROR) {
-        cerr << "CreateTexture : GL Error found : " << gluErrorString(error) << endl;
+        if (error != GL_NO_ERROR) {
+            cerr << "CreateTexture : GL Error found : " << gluErrorString(error) << endl;
+        }
     }
 #endif
 
     return image;
 }
 
+void cVideo::Upload_Texture(GLuint texture_id, unsigned int width, unsigned int height, const void* pixels, bool mipmap /* = 0 */) const
+{
+    // the texture name is only a number
+    if (game_headless) {
+        return;
+    }
+
+    // use the generated texture
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+
+    // set texture wrap modes which control how to interpret texture coordinates
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // set texture magnification function
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // upload to OpenGL texture
+    Create_GL_Texture(width, height, pixels, mipmap);
+}
+
 void cVideo::Create_GL_Texture(unsigned int width, unsigned int height, const void* pixels, bool mipmap /* = 0 */) const
 {
     // unsigned byte is an unsigned 8-bit integer (1 byte)
@@ -1172,6 +1369,9 @@ void cVideo::Create_GL_Texture(unsigned int width, unsigned int height, const vo
 
 Color cVideo::Get_Pixel(int x, int y) const
 {
+    // the frame must be finished
+    pVideo->Render_Finish();
+
     GLubyte* pixel = new GLubyte[3];
     // read it
     glReadPixels(x, y, 1, 1, GL_RGB, GL_UNSIGNED_BYTE, pixel);
@@ -1186,7 +1386,9 @@ Color cVideo::Get_Pixel(int x, int y) const
 
 void cVideo::Clear_Screen(void) const
 {
-    pRenderer->Add(new cClear_Request());
+    cClear_Request* request = new cClear_Request();
+    request->m_color = m_clear_color;
+    pRenderer->Add(request);
 }
 
 void cVideo::Draw_Rect(const GL_rect* rect, float z, const Color* color, cRect_Request* request /* = NULL */) const
@@ -20,6 +20,9 @@
 #include "../core/global_basic.hpp"
 #include "../core/global_game.hpp"
 #include "../video/color.hpp"
+#include "../video/gl_extensions.hpp"
+#include "../video/render_thread.hpp"
+#include "../video/sprite_shader.hpp"
 
 namespace TSC {
 
@@ -87,12 +90,33 @@ namespace TSC {
         // make the opengl context inactive for the current thread
         void Make_GL_Context_Inactive(void);
 
-        // Render. Should be called from a thread
-        void Render_From_Thread(void);
-        // Render game, GUI and swap the opengl buffer
+        /* Render game, GUI and swap the opengl buffer
+         * threaded : if set the game is rendered in the render thread
+         *   and this returns before it is finished
+        */
         void Render(bool threaded = 0);
-        // Finish thread rendering
+        /* Wait for the render thread and make the context current again
+         * needed before using OpenGL directly
+        */
         void Render_Finish(void);
+        // Return true if the render thread may be using the context
+        inline bool Is_Render_Pending(void) const
+        {
+            return m_render_pending;
+        }
+
+        /* Return a new texture name
+         * taken from the prepared names if the render thread is using the context
+        */
+        GLuint Gen_Texture(void);
+        // Delete the texture now or after the next frame if the render thread is using the context
+        void Delete_Texture(GLuint texture_id);
+        // Return a new buffer object name like Gen_Texture()
+        GLuint Gen_Buffer(void);
+        // Delete the buffer now or after the next frame if the render thread is using the context
+        void Delete_Buffer(GLuint buffer);
+        // Replace the buffer data now or before the next frame if the render thread is using the context
+        void Set_Buffer_Data(GLuint buffer, const void* data, size_t size, GLenum usage);
 
         // Toggle fullscreen video mode ( new mode is set to preferences )
         void Toggle_Fullscreen(void);
@@ -130,11 +154,13 @@ namespace TSC {
         /* Load and return the hardware image
          * use_settings : enable file settings if set to 1
          * print_errors : print errors if image couldn't be created or loaded
+         * atlas : if possible put the image into the texture atlas,
+         *   only for images which are kept until the atlas gets cleared
          * The returned image should be deleted if not used anymore
         */
         cGL_Surface* Load_GL_Surface(boost::filesystem::path filename, bool use_settings = 1, bool print_errors = 1);
         cGL_Surface* Load_GL_Package_Surface(boost::filesystem::path filename, bool use_settings = 1, bool print_errors = 1);
-        cGL_Surface* Load_GL_Surface_Helper(boost::filesystem::path filename, bool use_settings = 1, bool print_errors = 1, bool package = 1);
+        cGL_Surface* Load_GL_Surface_Helper(boost::filesystem::path filename, bool use_settings = 1, bool print_errors = 1, bool package = 1, bool atlas = 0);
 
         /* Convert to a scaled software image with a power of 2 size and 32 bits per pixel.
          * Conversion only happens if needed.
@@ -149,13 +175,16 @@ namespace TSC {
          * surface : the source SFML image which will be auto-deleted.
          * mipmap : create texture mipmaps
          * force_width/height : force the given width and height
+         * atlas : if possible put the image into the texture atlas instead of its own texture
         */
-        cGL_Surface* Create_Texture(sf::Image* p_sf_image, bool mipmap = 0, unsigned int force_width = 0, unsigned int force_height = 0) const;
+        cGL_Surface* Create_Texture(sf::Image* p_sf_image, bool mipmap = 0, unsigned int force_width = 0, unsigned int force_height = 0, bool atlas = 0) const;
 
         /* Copy pixels to the bound GL texture
          * mipmap : create texture mipmaps
         */
         void Create_GL_Texture(unsigned int width, unsigned int height, const void* pixels, bool mipmap = 0) const;
+        // Set the default parameters of the texture and copy the pixels to it
+        void Upload_Texture(GLuint texture_id, unsigned int width, unsigned int height, const void* pixels, bool mipmap = 0) const;
 
         // Get pixel color of the given position on the screen
         Color Get_Pixel(int x, int y) const;
@@ -199,10 +228,17 @@ namespace TSC {
 
         // available OpenGL version
         float m_opengl_version;
+        // OpenGL functions above version 1.1
+        cGL_Extensions m_gl_extensions;
+        // combines the colors of batched sprites if available
+        cSprite_Shader m_sprite_shader;
 
         // using double buffering
         bool m_double_buffer;
 
+        // color the screen is cleared with
+        Color m_clear_color;
+
         // screen red, green and blue color bit size
         int m_rgb_size[3];
 
@@ -231,14 +267,23 @@ namespace TSC {
         GLXContext glx_context;
 #endif
         // rendering thread
-        boost::thread m_render_thread;
+        cRender_Thread m_render_thread;
+        // if the last frame was given to the render thread and not finished
+        bool m_render_pending;
+        // names generated while the context was current for use while it is not
+        vector<GLuint> m_texture_names;
+        vector<GLuint> m_buffer_names;
 
-        // GUI System
-        CEGUI::OpenGLRenderer* mp_cegui_renderer;
+        // GUI System, the null renderer in headless mode
+        CEGUI::Renderer* mp_cegui_renderer;
 
         CEGUI::Tooltip* mp_default_tooltip;
 
         //private: // FIXME: Make these private:
+        /* Initialize without a window and OpenGL context
+         * textures only get a name and the render queue draws nothing
+        */
+        void Init_Video_Headless(void);
         // Initialize OpenGL with current settings
         void Init_OpenGL(void);
         // Initialize the CEGUI System and Renderer
@@ -249,6 +294,8 @@ namespace TSC {
         void Init_Texture_Detail(void);
         // initialize the up/down scaling value for the current resolution ( image/mouse scale )
         void Init_Resolution_Scale(void) const;
+        // Generate texture and buffer names for the next frame
+        void Fill_GL_Names(void);
 
         // if set video is initialized successfully
         bool m_initialised;